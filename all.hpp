@@ -25,4 +25,6 @@
 #include "datime.h"
 #include "toolbox.h"
 #include "file.h"
+#include "hash.h"
+#include "csv.h"
 #include "crypto/crypto.h"
@@ -0,0 +1,379 @@
+//
+// Created by piotr on 18.10.26.
+//
+// Pomiar wydajności szyfrów z crypto/: funkcje blokowe, wszystkie tryby,
+// rozwijanie klucza i niszczenie obiektów, dla danych od 8 B do 64 MB.
+// Każdy pomiar raportuje GB/s oraz cykle na bajt (licznik TSC na x86).
+//
+// Uruchomienie: ./crypto_bench --benchmark_filter=blowfish
+
+#include <benchmark/benchmark.h>
+#include "../crypto/crypto.h"
+#include "../toolbox.h"
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using namespace bee;
+using namespace bee::crypto;
+
+namespace {
+    constexpr i64 MIN_SIZE = 8;
+    constexpr i64 MAX_SIZE = 64 << 20;
+
+    u64 cycles() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    /// Pętla pomiarowa: wywołuje fn() w każdej iteracji i ustawia liczniki
+    /// GB/s oraz cycles/byte dla 'bytes' bajtów przetwarzanych w jednej iteracji.
+    template<typename Fn>
+    void measure(benchmark::State& state, size_t const bytes, Fn&& fn) {
+        auto const start = cycles();
+        for (auto _ : state)
+            fn();
+        auto const elapsed = cycles() - start;
+
+        auto const total = static_cast<double>(bytes) * static_cast<double>(state.iterations());
+        state.SetBytesProcessed(static_cast<i64>(total));
+        state.counters["GB/s"] = benchmark::Counter(total / 1e9, benchmark::Counter::kIsRate);
+        if (elapsed)
+            state.counters["cycles/byte"] = static_cast<double>(elapsed) / total;
+    }
+
+    /// Wspólny bufor losowych danych.
+    /// \param nbytes Liczba bajtów potrzebnych w pomiarze (nie więcej niż MAX_SIZE + 64).
+    std::vector<u8> const& data(size_t const nbytes) {
+        static std::vector<u8> const buffer = box::random_bytes<u8>(MAX_SIZE + 64);
+        if (nbytes > buffer.size())
+            throw std::length_error{"benchmark data buffer is too small"};
+        return buffer;
+    }
+
+    // Klucze testowe i obiekty szyfrów (jedna instancja na typ).
+    constexpr u8 KEY1[32] = {
+        0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10,
+        0x0f, 0x1e, 0x2d, 0x3c, 0x4b, 0x5a, 0x69, 0x78, 0x87, 0x96, 0xa5, 0xb4, 0xc3, 0xd2, 0xe1, 0xf0
+    };
+    constexpr u8 KEY2[32] = {
+        0xf0, 0xe1, 0xd2, 0xc3, 0xb4, 0xa5, 0x96, 0x87, 0x78, 0x69, 0x5a, 0x4b, 0x3c, 0x2d, 0x1e, 0x0f,
+        0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe, 0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01
+    };
+
+    template<typename Cipher>
+    Cipher const& first() {
+        static Cipher const cipher{KEY1, sizeof(KEY1)};
+        return cipher;
+    }
+
+    template<typename Cipher>
+    Cipher const& second() {
+        static Cipher const cipher{KEY2, sizeof(KEY2)};
+        return cipher;
+    }
+
+    constexpr u8 IV[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+}
+
+/****************************************************************
+*                    f u n k c j e  b l o k o w e               *
+****************************************************************/
+
+template<typename Cipher>
+void block_encrypt(benchmark::State& state) {
+    auto const& cipher = first<Cipher>();
+    u32 block[2]{0x01234567, 0x89abcdef};
+    measure(state, 8, [&] {
+        cipher.encrypt_block(block, block);
+        benchmark::DoNotOptimize(block);
+    });
+}
+
+template<typename Cipher>
+void block_decrypt(benchmark::State& state) {
+    auto const& cipher = first<Cipher>();
+    u32 block[2]{0x01234567, 0x89abcdef};
+    measure(state, 8, [&] {
+        cipher.decrypt_block(block, block);
+        benchmark::DoNotOptimize(block);
+    });
+}
+
+BENCHMARK_TEMPLATE(block_encrypt, blowfish);
+BENCHMARK_TEMPLATE(block_decrypt, blowfish);
+BENCHMARK_TEMPLATE(block_encrypt, gost);
+BENCHMARK_TEMPLATE(block_decrypt, gost);
+
+/****************************************************************
+*                          t r y b y                            *
+****************************************************************/
+
+static void blowfish_ecb_encrypt(benchmark::State& state) {
+    auto const n = static_cast<size_t>(state.range(0));
+    auto const& input = data(n);
+    measure(state, n, [&] {
+        benchmark::DoNotOptimize(first<blowfish>().encrypt_ecb(input.data(), n));
+    });
+}
+
+static void blowfish_ecb_decrypt(benchmark::State& state) {
+    auto const n = static_cast<size_t>(state.range(0));
+    auto const cipher = first<blowfish>().encrypt_ecb(data(n).data(), n);
+    measure(state, n, [&] {
+        benchmark::DoNotOptimize(first<blowfish>().decrypt_ecb(cipher.data(), cipher.size()));
+    });
+}
+
+static void blowfish_cbc_encrypt(benchmark::State& state) {
+    auto const n = static_cast<size_t>(state.range(0));
+    auto const& input = data(n);
+    measure(state, n, [&] {
+        benchmark::DoNotOptimize(first<blowfish>().encrypt_cbc(input.data(), n));
+    });
+}
+
+static void blowfish_cbc_decrypt(benchmark::State& state) {
+    auto const n = static_cast<size_t>(state.range(0));
+    auto const cipher = first<blowfish>().encrypt_cbc(data(n).data(), n);
+    measure(state, n, [&] {
+        benchmark::DoNotOptimize(first<blowfish>().decrypt_cbc(cipher.data(), cipher.size()));
+    });
+}
+
+// Nagłówek, treść i stopka w osobnych buforach.
+static void blowfish_cbc_encrypt_iovec(benchmark::State& state) {
+    auto const n = static_cast<size_t>(state.range(0));
+    auto const& input = data(n);
+    auto const head = std::min<size_t>(n, 5);
+    auto const tail = std::min<size_t>(n - head, 3);
+    std::span<u8 const> const in[]{
+        {input.data(), head},
+        {input.data() + head, n - head - tail},
+        {input.data() + n - tail, tail}
+    };
+    std::vector<u8> output(n + 16);
+    std::span<u8> const out[]{{output.data(), output.size()}};
+    measure(state, n, [&] {
+        benchmark::DoNotOptimize(first<blowfish>().encrypt_cbc(const_fragments{in}, fragments{out}, IV));
+    });
+}
+
+// Wsad 64 wiadomości o rozmiarze n.
+static void blowfish_cbc_encrypt_batch(benchmark::State& state) {
+    constexpr size_t COUNT = 64;
+    auto const n = static_cast<size_t>(state.range(0));
+    std::vector<std::span<u8 const>> messages(COUNT, std::span<u8 const>{data(n).data(), n});
+    measure(state, n * COUNT, [&] {
+        benchmark::DoNotOptimize(first<blowfish>().encrypt_cbc_batch(std::span<std::span<u8 const> const>{messages}));
+    });
+}
+
+// Osiem sesji z własnymi kluczami, każda szyfruje pakiet o rozmiarze n (ECB/CBC bez 'uzupełnienia').
+static blowfish const& session(size_t const i) {
+    static std::vector<blowfish> const ciphers = [] {
+        std::vector<blowfish> v;
+        for (size_t k = 0; k < multi_buffer::LANES; ++k) {
+            u8 key[sizeof(KEY1)];
+            std::memcpy(key, KEY1, sizeof(key));
+            key[0] ^= static_cast<u8>(k);
+            v.emplace_back(key, sizeof(key));
+        }
+        return v;
+    }();
+    return ciphers[i];
+}
+
+static void blowfish_sessions_sequential(benchmark::State& state) {
+    auto const n = static_cast<size_t>(state.range(0)) / 8 * 8;
+    auto const& input = data(n * multi_buffer::LANES);
+    std::vector<u8> buffer(input.begin(), input.begin() + static_cast<i64>(n * multi_buffer::LANES));
+    measure(state, n * multi_buffer::LANES, [&] {
+        for (size_t k = 0; k < multi_buffer::LANES; ++k) {
+            auto const& cipher = session(k);
+            auto const ptr = reinterpret_cast<u32*>(buffer.data() + k * n);
+            for (size_t i = 0; i < n / 4; i += 2)
+                cipher.encrypt_block(ptr + i, ptr + i);
+        }
+        benchmark::DoNotOptimize(buffer.data());
+    });
+}
+
+static void blowfish_sessions_multi_buffer(benchmark::State& state) {
+    auto const n = static_cast<size_t>(state.range(0)) / 8 * 8;
+    auto const& input = data(n * multi_buffer::LANES);
+    std::vector<u8> buffer(input.begin(), input.begin() + static_cast<i64>(n * multi_buffer::LANES));
+    std::vector<multi_buffer::job> jobs;
+    for (size_t k = 0; k < multi_buffer::LANES; ++k)
+        jobs.push_back({&session(k), buffer.data() + k * n, buffer.data() + k * n, n});
+    measure(state, n * multi_buffer::LANES, [&] {
+        multi_buffer::encrypt(jobs);
+        benchmark::DoNotOptimize(buffer.data());
+    });
+}
+
+template<typename Cipher>
+void ofb(benchmark::State& state) {
+    auto const n = static_cast<size_t>(state.range(0));
+    auto const& input = data(n);
+    measure(state, n, [&] {
+        benchmark::DoNotOptimize(first<Cipher>().encrypt_ofb(input.data(), n, IV));
+    });
+}
+
+template<typename Cipher>
+void cfb_encrypt(benchmark::State& state) {
+    auto const n = static_cast<size_t>(state.range(0));
+    auto const& input = data(n);
+    measure(state, n, [&] {
+        benchmark::DoNotOptimize(first<Cipher>().encrypt_cfb(input.data(), n, IV));
+    });
+}
+
+template<typename Cipher>
+void cfb_decrypt(benchmark::State& state) {
+    auto const n = static_cast<size_t>(state.range(0));
+    auto const cipher = first<Cipher>().encrypt_cfb(data(n).data(), n, IV);
+    measure(state, n, [&] {
+        benchmark::DoNotOptimize(first<Cipher>().decrypt_cfb(cipher.data(), cipher.size()));
+    });
+}
+
+// Strumień OFB liczony w tle - mierzony jest tylko XOR po stronie wywołującego.
+template<typename Cipher>
+void ofb_keystream(benchmark::State& state) {
+    auto const n = static_cast<size_t>(state.range(0));
+    auto const& input = data(n);
+    std::vector<u8> output(n);
+    keystream<Cipher> ks{first<Cipher>(), IV};
+    measure(state, n, [&] {
+        ks.apply(input.data(), output.data(), n);
+        benchmark::DoNotOptimize(output.data());
+    });
+}
+
+template<typename Cipher>
+void xts_encrypt(benchmark::State& state) {
+    auto const n = static_cast<size_t>(state.range(0));
+    auto const& input = data(n);
+    std::vector<u8> buffer(input.begin(), input.begin() + static_cast<i64>(n));
+    xts<Cipher> const mode{first<Cipher>(), second<Cipher>()};
+    u64 sector = 0;
+    measure(state, n, [&] {
+        mode.encrypt_sector(sector++, buffer.data(), buffer.data(), n);
+        benchmark::DoNotOptimize(buffer.data());
+    });
+}
+
+template<typename Cipher>
+void authenticated_encrypt(benchmark::State& state) {
+    auto const n = static_cast<size_t>(state.range(0));
+    auto const& input = data(n);
+    authenticated<Cipher> const mode{first<Cipher>(), second<Cipher>()};
+    measure(state, n, [&] {
+        benchmark::DoNotOptimize(mode.encrypt(input.data(), n, IV));
+    });
+}
+
+template<typename Cipher>
+void authenticated_decrypt(benchmark::State& state) {
+    auto const n = static_cast<size_t>(state.range(0));
+    authenticated<Cipher> const mode{first<Cipher>(), second<Cipher>()};
+    auto const cipher = mode.encrypt(data(n).data(), n, IV);
+    measure(state, n, [&] {
+        benchmark::DoNotOptimize(mode.decrypt(cipher.data(), cipher.size()));
+    });
+}
+
+#define SIZES RangeMultiplier(8)->Range(MIN_SIZE, MAX_SIZE)
+
+BENCHMARK(blowfish_ecb_encrypt)->SIZES;
+BENCHMARK(blowfish_ecb_decrypt)->SIZES;
+BENCHMARK(blowfish_cbc_encrypt)->SIZES;
+BENCHMARK(blowfish_cbc_decrypt)->SIZES;
+BENCHMARK(blowfish_cbc_encrypt_iovec)->SIZES;
+BENCHMARK(blowfish_cbc_encrypt_batch)->RangeMultiplier(8)->Range(MIN_SIZE, 1 << 20);
+BENCHMARK(blowfish_sessions_sequential)->RangeMultiplier(8)->Range(MIN_SIZE, 1 << 20);
+BENCHMARK(blowfish_sessions_multi_buffer)->RangeMultiplier(8)->Range(MIN_SIZE, 1 << 20);
+BENCHMARK_TEMPLATE(ofb, blowfish)->SIZES;
+BENCHMARK_TEMPLATE(ofb, gost)->SIZES;
+BENCHMARK_TEMPLATE(cfb_encrypt, blowfish)->SIZES;
+BENCHMARK_TEMPLATE(cfb_encrypt, gost)->SIZES;
+BENCHMARK_TEMPLATE(cfb_decrypt, blowfish)->SIZES;
+BENCHMARK_TEMPLATE(cfb_decrypt, gost)->SIZES;
+BENCHMARK_TEMPLATE(ofb_keystream, blowfish)->SIZES;
+BENCHMARK_TEMPLATE(ofb_keystream, gost)->SIZES;
+BENCHMARK_TEMPLATE(xts_encrypt, blowfish)->SIZES;
+BENCHMARK_TEMPLATE(xts_encrypt, gost)->SIZES;
+BENCHMARK_TEMPLATE(authenticated_encrypt, blowfish)->SIZES;
+BENCHMARK_TEMPLATE(authenticated_encrypt, gost)->SIZES;
+BENCHMARK_TEMPLATE(authenticated_decrypt, blowfish)->SIZES;
+BENCHMARK_TEMPLATE(authenticated_decrypt, gost)->SIZES;
+
+/****************************************************************
+*            k l u c z e  i  n i s z c z e n i e                *
+****************************************************************/
+
+template<typename Cipher>
+void key_setup(benchmark::State& state) {
+    measure(state, sizeof(KEY1), [&] {
+        Cipher cipher{KEY1, sizeof(KEY1)};
+        benchmark::DoNotOptimize(cipher);
+    });
+}
+
+static void blowfish_from_schedule(benchmark::State& state) {
+    auto const blob = first<blowfish>().export_schedule();
+    measure(state, blob.size(), [&] {
+        benchmark::DoNotOptimize(blowfish::from_schedule(blob.data(), blob.size()));
+    });
+}
+
+// Sam destruktor: obiekty tworzone są poza pomiarem czasu.
+template<typename Cipher>
+void teardown(benchmark::State& state) {
+    constexpr size_t COUNT = 64;
+    std::vector<Cipher> ciphers;
+    ciphers.reserve(COUNT);
+
+    auto const start = cycles();
+    u64 excluded = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto const pause = cycles();
+        for (size_t i = 0; i < COUNT; ++i)
+            ciphers.emplace_back(KEY1, sizeof(KEY1));
+        excluded += cycles() - pause;
+        state.ResumeTiming();
+
+        ciphers.clear();
+    }
+    auto const elapsed = cycles() - start - excluded;
+    state.SetItemsProcessed(static_cast<i64>(state.iterations() * COUNT));
+    if (elapsed)
+        state.counters["cycles/object"] = static_cast<double>(elapsed) / static_cast<double>(state.iterations() * COUNT);
+}
+
+static void clear_bytes(benchmark::State& state) {
+    auto const n = static_cast<size_t>(state.range(0));
+    auto const policy = state.range(1) ? wipe_policy::multi_pass : wipe_policy::zero;
+    std::vector<u8> buffer(n);
+    measure(state, n, [&] {
+        crypto::clear_bytes(buffer.data(), n, policy);
+    });
+}
+
+BENCHMARK_TEMPLATE(key_setup, blowfish);
+BENCHMARK_TEMPLATE(key_setup, gost);
+BENCHMARK(blowfish_from_schedule);
+BENCHMARK_TEMPLATE(teardown, blowfish);
+BENCHMARK_TEMPLATE(teardown, gost);
+BENCHMARK(clear_bytes)->ArgsProduct({benchmark::CreateRange(MIN_SIZE, MAX_SIZE, 8), {0, 1}});
+
+BENCHMARK_MAIN();
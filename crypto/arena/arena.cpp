@@ -0,0 +1,148 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#include "arena.h"
+#include "../crypto.h"
+#include <algorithm>
+#include <bit>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace bee::crypto {
+    namespace {
+        size_t page_size() noexcept {
+            static size_t const size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            return size;
+        }
+
+        size_t round_to_pages(size_t const nbytes) noexcept {
+            auto const page = page_size();
+            return (nbytes + page - 1) / page * page;
+        }
+    }
+
+    arena& arena::instance() noexcept {
+        // Celowo nigdy nie niszczony - obiekty statyczne z kluczami
+        // mogą być zwalniane po zakończeniu main.
+        static auto const instance = new arena;
+        return *instance;
+    }
+
+    size_t arena::class_index(size_t const nbytes) noexcept {
+        auto const shift = static_cast<size_t>(std::bit_width(std::max(nbytes, size_t{1}) - 1));
+        return shift <= MIN_CLASS_SHIFT ? 0 : shift - MIN_CLASS_SHIFT;
+    }
+
+    // Klasa dużego bloku: rozmiar (wielokrotność strony) zaokrąglony w górę do potęgi dwójki.
+    size_t arena::large_class_shift(size_t const nbytes) noexcept {
+        return static_cast<size_t>(std::bit_width(round_to_pages(nbytes) - 1));
+    }
+
+    void* arena::map_pages(size_t const nbytes) noexcept {
+        void* const ptr = mmap(nullptr, nbytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED)
+            return nullptr;
+
+        // Brak blokady nie jest błędem krytycznym (np. niski RLIMIT_MEMLOCK),
+        // pamięć nadal jest używana, ale locked() zwróci false.
+        if (mlock(ptr, nbytes) != 0)
+            locked_.store(false, std::memory_order_relaxed);
+#ifdef MADV_DONTDUMP
+        madvise(ptr, nbytes, MADV_DONTDUMP);
+#endif
+        return ptr;
+    }
+
+    void arena::unmap_pages(void* const ptr, size_t const nbytes) noexcept {
+        munlock(ptr, nbytes);
+        munmap(ptr, nbytes);
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                      a l l o c a t e                          *
+    *                                                               *
+    ****************************************************************/
+
+    void* arena::allocate(size_t const nbytes) noexcept {
+        if (nbytes > MAX_CLASS) {
+            auto const shift = large_class_shift(nbytes);
+            if (shift >= LARGE_CLASS_COUNT)
+                return nullptr;
+
+            std::lock_guard lock{mutex_};
+            if (auto const head = large_free_[shift]) {
+                large_free_[shift] = head->next;
+                large_cached_ -= size_t{1} << shift;
+                head->next = nullptr;
+                return head;
+            }
+            return map_pages(size_t{1} << shift);
+        }
+
+        auto const idx = class_index(nbytes);
+        auto const size = size_t{1} << (idx + MIN_CLASS_SHIFT);
+
+        std::lock_guard lock{mutex_};
+
+        // Najpierw odzyskujemy blok z listy wolnych.
+        if (auto const head = free_[idx]) {
+            free_[idx] = head->next;
+            head->next = nullptr;
+            return head;
+        }
+
+        // Bloki wyrównane do rozmiaru klasy, ale nie więcej niż do linii cache.
+        auto const align = std::min(size, size_t{64});
+        auto offset = (chunk_used_ + align - 1) & ~(align - 1);
+        if (offset + size > CHUNK_SIZE) {
+            // Reszta bieżącego fragmentu przepada - fragmenty nie są zwracane do systemu.
+            auto const chunk = static_cast<u8*>(map_pages(CHUNK_SIZE));
+            if (!chunk)
+                return nullptr;
+            chunk_ = chunk;
+            offset = 0;
+        }
+        chunk_used_ = offset + size;
+        return chunk_ + offset;
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                    d e a l l o c a t e                        *
+    *                                                               *
+    ****************************************************************/
+
+    void arena::deallocate(void* const ptr, size_t const nbytes) noexcept {
+        if (!ptr)
+            return;
+
+        if (nbytes > MAX_CLASS) {
+            // Poza pierwszymi nbytes bajtami blok nie był zapisywany (zera z mmap lub z poprzedniego zwolnienia).
+            secure_zero(ptr, nbytes);
+            auto const shift = large_class_shift(nbytes);
+            auto const size = size_t{1} << shift;
+            {
+                std::lock_guard lock{mutex_};
+                if (large_cached_ + size <= LARGE_CACHE_SIZE) {
+                    auto const head = static_cast<node*>(ptr);
+                    head->next = large_free_[shift];
+                    large_free_[shift] = head;
+                    large_cached_ += size;
+                    return;
+                }
+            }
+            unmap_pages(ptr, size);
+            return;
+        }
+
+        auto const idx = class_index(nbytes);
+        secure_zero(ptr, size_t{1} << (idx + MIN_CLASS_SHIFT));
+
+        std::lock_guard lock{mutex_};
+        auto const head = static_cast<node*>(ptr);
+        head->next = free_[idx];
+        free_[idx] = head;
+    }
+}
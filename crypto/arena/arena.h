@@ -0,0 +1,115 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#pragma once
+#include "../../types.h"
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace bee::crypto {
+    /// Pula pamięci na dane wrażliwe (klucze, jawne teksty).
+    /// Strony pamięci są zablokowane w RAM (mlock) i wyłączone ze zrzutów (MADV_DONTDUMP).
+    /// Małe bloki (do MAX_CLASS bajtów) są przydzielane z klas rozmiarów
+    /// i po zwolnieniu (oraz wyzerowaniu) trafiają na listę wolnych bloków swojej klasy.
+    /// Większe bloki mają własne strony o rozmiarze zaokrąglonym do potęgi dwójki; po zwolnieniu
+    /// (i wyzerowaniu) trafiają na listę wolnych bloków swojej klasy, dopóki łączny rozmiar
+    /// takich bloków nie przekracza LARGE_CACHE_SIZE - dopiero nadmiar wraca do systemu.
+    /// Dzięki temu powtarzane szyfrowanie dużych danych nie kosztuje za każdym razem mmap/mlock.
+    class arena final {
+        static constexpr size_t MIN_CLASS_SHIFT = 4;    // 16 bajtów
+        static constexpr size_t MAX_CLASS_SHIFT = 14;   // 16 KiB
+        static constexpr size_t MAX_CLASS = size_t{1} << MAX_CLASS_SHIFT;
+        static constexpr size_t CLASS_COUNT = MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1;
+        static constexpr size_t CHUNK_SIZE = 256 * 1024;
+        static constexpr size_t LARGE_CLASS_COUNT = 64;
+        static constexpr size_t LARGE_CACHE_SIZE = 32 * 1024 * 1024;
+
+        struct node {
+            node* next;
+        };
+
+        std::mutex mutex_;
+        std::array<node*, CLASS_COUNT> free_{};
+        std::array<node*, LARGE_CLASS_COUNT> large_free_{};
+        size_t large_cached_{};
+        u8* chunk_{};
+        size_t chunk_used_{CHUNK_SIZE};
+        std::atomic<bool> locked_{true};
+
+        arena() = default;
+    public:
+        arena(arena const&) = delete;
+        arena& operator=(arena const&) = delete;
+
+        static arena& instance() noexcept;
+
+        /// Przydział bloku pamięci.
+        /// \return Wskaźnik na blok lub nullptr, jeśli nie udało się zmapować pamięci.
+        void* allocate(size_t nbytes) noexcept;
+
+        /// Wyzerowanie i zwolnienie bloku.
+        /// \param nbytes Rozmiar przekazany wcześniej do allocate.
+        void deallocate(void* ptr, size_t nbytes) noexcept;
+
+        /// Czy wszystkie strony udało się zablokować w RAM (limit RLIMIT_MEMLOCK).
+        [[nodiscard]] bool locked() const noexcept { return locked_.load(std::memory_order_relaxed); }
+
+    private:
+        void* map_pages(size_t nbytes) noexcept;
+        static void unmap_pages(void* ptr, size_t nbytes) noexcept;
+        static size_t class_index(size_t nbytes) noexcept;
+        static size_t large_class_shift(size_t nbytes) noexcept;
+    };
+
+    /// Alokator dla kontenerów STL korzystający z arena.
+    template<typename T>
+    struct secure_allocator {
+        using value_type = T;
+
+        secure_allocator() noexcept = default;
+        template<typename U>
+        secure_allocator(secure_allocator<U> const&) noexcept {}
+
+        T* allocate(size_t const n) {
+            if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+                throw std::bad_array_new_length{};
+            if (auto const ptr = arena::instance().allocate(n * sizeof(T)))
+                return static_cast<T*>(ptr);
+            throw std::bad_alloc{};
+        }
+
+        void deallocate(T* const ptr, size_t const n) noexcept {
+            arena::instance().deallocate(ptr, n * sizeof(T));
+        }
+
+        template<typename U>
+        bool operator==(secure_allocator<U> const&) const noexcept { return true; }
+    };
+
+    using secure_bytes = std::vector<u8, secure_allocator<u8>>;
+
+    /// Deleter dla secure_ptr: destruktor obiektu, a następnie wyzerowanie jego pamięci.
+    template<typename T>
+    struct secure_delete {
+        void operator()(T* const ptr) const noexcept {
+            ptr->~T();
+            arena::instance().deallocate(ptr, sizeof(T));
+        }
+    };
+
+    template<typename T>
+    using secure_ptr = std::unique_ptr<T, secure_delete<T>>;
+
+    /// Utworzenie obiektu (zainicjalizowanego wartością) w pamięci z arena.
+    template<typename T, typename... Args>
+    auto make_secure(Args&&... args) -> secure_ptr<T> {
+        auto const ptr = secure_allocator<T>{}.allocate(1);
+        return secure_ptr<T>{new (ptr) T{std::forward<Args>(args)...}};
+    }
+}
@@ -5,15 +5,43 @@
 #include "blowfish.h"
 #include "data.h"
 #include "../crypto.h"
+#include "../stream/stream.h"
 #include <vector>
+#include <cassert>
 #include <iostream>
 #include <cstring>  // for std::memcpy
 
 #include "../../toolbox.h"
 
 namespace bee::crypto {
+    namespace {
+        void put_u32(u8* const dst, u32 const v) noexcept {
+            dst[0] = static_cast<u8>(v);
+            dst[1] = static_cast<u8>(v >> 8);
+            dst[2] = static_cast<u8>(v >> 16);
+            dst[3] = static_cast<u8>(v >> 24);
+        }
+
+        u32 get_u32(u8 const* const src) noexcept {
+            return static_cast<u32>(src[0])
+                | static_cast<u32>(src[1]) << 8
+                | static_cast<u32>(src[2]) << 16
+                | static_cast<u32>(src[3]) << 24;
+        }
+
+        // Suma kontrolna bloba (FNV-1a, 64 bity). Bez klucza - wykrywa tylko przypadkowe uszkodzenie.
+        u64 schedule_tag(u8 const* const data, size_t const nbytes) noexcept {
+            u64 h = 0xcbf29ce484222325;
+            for (size_t i = 0; i < nbytes; ++i) {
+                h ^= data[i];
+                h *= 0x100000001b3;
+            }
+            return h;
+        }
+    }
 
     blowfish::blowfish(void const* const key_material, size_t const key_size)
+        : blowfish()
     {
         if (key_size < KEY_MINSIZE || key_size > KEY_MAXSIZE) {
             std::cerr << "Error (blowfish): invalid key size\n";
@@ -21,6 +49,7 @@ namespace bee::crypto {
         }
 
         auto const key = static_cast<u8 const*>(key_material);
+        auto& [p, s] = *ks_;
 
         // S - init
         for (int i = 0; i < 4; ++i) {
@@ -62,12 +91,82 @@ namespace bee::crypto {
         }
     }
 
-    blowfish::~blowfish() {
-        clear_bytes(p, (ROUND_COUNT+2) * sizeof(u32));
-        clear_bytes(s[0], 256 * sizeof(u32));
-        clear_bytes(s[1], 256 * sizeof(u32));
-        clear_bytes(s[2], 256 * sizeof(u32));
-        clear_bytes(s[3], 256 * sizeof(u32));
+    /****************************************************************
+    *                                                               *
+    *               e x p o r t _ s c h e d u l e                   *
+    *                                                               *
+    ****************************************************************/
+
+    auto blowfish::export_schedule() const noexcept
+    -> secure_bytes
+    {
+        assert(ks_ && "blowfish: use of a moved-from object");
+        secure_bytes blob(SCHEDULE_SIZE, 0);
+        auto ptr = blob.data();
+
+        put_u32(ptr, SCHEDULE_MAGIC);
+        put_u32(ptr + 4, SCHEDULE_VERSION);
+        ptr += SCHEDULE_HEADER_SIZE;
+
+        for (auto const v : ks_->p) {
+            put_u32(ptr, v);
+            ptr += sizeof(u32);
+        }
+        for (auto const& row : ks_->s) {
+            for (auto const v : row) {
+                put_u32(ptr, v);
+                ptr += sizeof(u32);
+            }
+        }
+
+        // Tag obejmuje nagłówek i obie tablice.
+        u64 const tag = schedule_tag(blob.data(), SCHEDULE_HEADER_SIZE + SCHEDULE_TABLES_SIZE);
+        put_u32(ptr, static_cast<u32>(tag));
+        put_u32(ptr + 4, static_cast<u32>(tag >> 32));
+
+        return blob;
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                 f r o m _ s c h e d u l e                     *
+    *                                                               *
+    ****************************************************************/
+
+    auto blowfish::from_schedule(void const* const data, size_t const nbytes) noexcept
+    -> std::optional<blowfish>
+    {
+        if (data == nullptr || nbytes != SCHEDULE_SIZE) {
+            std::cerr << "Error (blowfish): invalid schedule size\n";
+            return {};
+        }
+
+        auto ptr = static_cast<u8 const*>(data);
+        if (get_u32(ptr) != SCHEDULE_MAGIC || get_u32(ptr + 4) != SCHEDULE_VERSION) {
+            std::cerr << "Error (blowfish): unsupported schedule version\n";
+            return {};
+        }
+
+        auto const tag_ptr = ptr + SCHEDULE_HEADER_SIZE + SCHEDULE_TABLES_SIZE;
+        auto const tag = static_cast<u64>(get_u32(tag_ptr)) | static_cast<u64>(get_u32(tag_ptr + 4)) << 32;
+        if (tag != schedule_tag(ptr, SCHEDULE_HEADER_SIZE + SCHEDULE_TABLES_SIZE)) {
+            std::cerr << "Error (blowfish): schedule checksum mismatch\n";
+            return {};
+        }
+
+        blowfish bf{};
+        ptr += SCHEDULE_HEADER_SIZE;
+        for (auto& v : bf.ks_->p) {
+            v = get_u32(ptr);
+            ptr += sizeof(u32);
+        }
+        for (auto& row : bf.ks_->s) {
+            for (auto& v : row) {
+                v = get_u32(ptr);
+                ptr += sizeof(u32);
+            }
+        }
+        return bf;
     }
 
 
@@ -78,6 +177,8 @@ namespace bee::crypto {
     ****************************************************************/
 
     void blowfish::encrypt_block(u32 const* const src, u32* const dst) const noexcept {
+        assert(ks_ && "blowfish: use of a moved-from object");
+        auto const& p = ks_->p;
         u32 xl = src[0];
         u32 xr = src[1];
 
@@ -133,6 +234,8 @@ namespace bee::crypto {
     ****************************************************************/
 
     void blowfish::decrypt_block(u32 const* const src, u32* const dst) const noexcept {
+        assert(ks_ && "blowfish: use of a moved-from object");
+        auto const& p = ks_->p;
         u32 xl = src[0];
         u32 xr = src[1];
 
@@ -198,7 +301,7 @@ namespace bee::crypto {
         auto const ptr = static_cast<unsigned char const*>(data);
 
         // Bufor z jawnymi danymi.
-        std::vector<unsigned char> plain{ptr, ptr + nbytes};
+        secure_bytes plain{ptr, ptr + nbytes};
         auto size = plain.size();
         if (size % BLOCK_SIZE) {
             auto const blocks = (size / BLOCK_SIZE) + 1;
@@ -210,14 +313,14 @@ namespace bee::crypto {
         // Bufor na zaszyfrowane dane.
         std::vector<u8> cipher(size, 0);
 
-        // Szyfrowanie.
-        auto src = reinterpret_cast<u32 const*>(plain.data());
-        auto dst = reinterpret_cast<u32*>(cipher.data());
-        for (int i = 0; i < (size/BLOCK_SIZE); ++i) {
-            encrypt_block(src, dst);
-            src += 2;
-            dst += 2;
+        // Szyfrowanie (słowa bloku zapisane jako little-endian).
+        u32 block[2];
+        for (size_t pos = 0; pos < size; pos += BLOCK_SIZE) {
+            load_le32(plain.data() + pos, block);
+            encrypt_block(block, block);
+            store_le32(cipher.data() + pos, block);
         }
+        secure_zero(block, sizeof(block));
 
         return std::move(cipher);
     }
@@ -238,13 +341,14 @@ namespace bee::crypto {
         std::vector<u8> plain(nbytes, 0);
 
         // Odszyfrowanie
-        auto src = static_cast<u32 const*>(cipher);
-        auto dst = reinterpret_cast<u32*>(plain.data());
-        for (int i = 0; i < (nbytes/BLOCK_SIZE); ++i) {
-            decrypt_block(src, dst);
-            src += 2;
-            dst += 2;
+        auto const src = static_cast<u8 const*>(cipher);
+        u32 block[2];
+        for (size_t pos = 0; pos + BLOCK_SIZE <= nbytes; pos += BLOCK_SIZE) {
+            load_le32(src + pos, block);
+            decrypt_block(block, block);
+            store_le32(plain.data() + pos, block);
         }
+        secure_zero(block, sizeof(block));
 
         // Obcięcie 'ogona'.
         if (int const idx = padding_index(plain.data(), static_cast<int>(nbytes)); idx != -1)
@@ -271,7 +375,7 @@ namespace bee::crypto {
         auto const ptr = static_cast<u8 const*>(data);
 
         // Bufor z jawnymi danymi.
-        std::vector<u8> plain{ptr, ptr + nbytes};
+        secure_bytes plain{ptr, ptr + nbytes};
         auto size = plain.size();
         if (size % BLOCK_SIZE) {
             auto const blocks = (size / BLOCK_SIZE) + 1;
@@ -286,22 +390,22 @@ namespace bee::crypto {
         if (iv)
             std::memcpy(cipher.data(), iv, BLOCK_SIZE);
         else
-            std::memcpy(cipher.data(), box::random_bytes<u8>(BLOCK_SIZE).data(), BLOCK_SIZE);
+            box::fill_random(cipher.data(), BLOCK_SIZE);
 
         // std::cout << std::format("I: {}\n", box::bytes_to_string(cipher, BLOCK_SIZE, true));
 
 
         // Szyfrowanie.
-        auto src = reinterpret_cast<u32 const*>(plain.data());
-        auto dst = reinterpret_cast<u32*>(cipher.data());
-        u32 tmp[2];
-        for (int i = 0; i < (size/BLOCK_SIZE); ++i) {
-            tmp[0] = src[0] ^ dst[0];
-            tmp[1] = src[1] ^ dst[1];
-            dst += 2;
-            encrypt_block(tmp, dst);
-            src += 2;
+        u32 chain[2], block[2];
+        load_le32(cipher.data(), chain);
+        for (size_t pos = 0; pos < size; pos += BLOCK_SIZE) {
+            load_le32(plain.data() + pos, block);
+            block[0] ^= chain[0];
+            block[1] ^= chain[1];
+            encrypt_block(block, chain);
+            store_le32(cipher.data() + BLOCK_SIZE + pos, chain);
         }
+        secure_zero(block, sizeof(block));
         return std::move(cipher);
     }
 
@@ -322,15 +426,20 @@ namespace bee::crypto {
         std::vector<u8> plain(nbytes, 0);
 
         // Odszyfrowanie.
-        auto src = static_cast<u32 const*>(cipher);
-        auto dst = reinterpret_cast<u32*>(plain.data());
-        for (int i = 0; i < (nbytes/BLOCK_SIZE); ++i) {
-            decrypt_block(src + 2, dst);
-            dst[0] = dst[0] ^ src[0];
-            dst[1] = dst[1] ^ src[1];
-            src += 2;
-            dst += 2;
+        auto const src = static_cast<u8 const*>(cipher);
+        u32 chain[2], block[2];
+        load_le32(src, chain);
+        for (size_t pos = 0; pos + BLOCK_SIZE <= nbytes; pos += BLOCK_SIZE) {
+            u32 next[2];
+            load_le32(src + BLOCK_SIZE + pos, next);
+            decrypt_block(next, block);
+            block[0] ^= chain[0];
+            block[1] ^= chain[1];
+            store_le32(plain.data() + pos, block);
+            chain[0] = next[0];
+            chain[1] = next[1];
         }
+        secure_zero(block, sizeof(block));
 
         // Obcięcie 'ogona'.
         if (int const idx = padding_index(plain.data(), static_cast<int>(nbytes)); idx != -1)
@@ -338,4 +447,264 @@ namespace bee::crypto {
 
         return std::move(plain);
     }
+
+    /****************************************************************
+    *                                                               *
+    *                  s c a t t e r - g a t h e r                  *
+    *                                                               *
+    ****************************************************************/
+
+    size_t blowfish::encrypt_fragments(const_fragments const in, fragments const out, bool const cbc, void const* const iv) const noexcept {
+        auto const nbytes = total_size(in);
+        if (nbytes == 0)
+            return 0;
+
+        auto const size = (nbytes + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+        auto const out_size = cbc ? size + BLOCK_SIZE : size;
+        if (total_size(out) < out_size)
+            return 0;
+
+        gather src{in};
+        scatter dst{out};
+
+        u32 chain[2]{};
+        if (cbc) {
+            u8 first[BLOCK_SIZE];
+            if (iv)
+                std::memcpy(first, iv, BLOCK_SIZE);
+            else
+                box::fill_random(first, BLOCK_SIZE);
+            load_le32(first, chain);
+            dst.write(first, BLOCK_SIZE);
+        }
+
+        u8 block[BLOCK_SIZE];
+        for (size_t i = 0; i < size / BLOCK_SIZE; ++i) {
+            std::memset(block, 0, BLOCK_SIZE);
+            if (auto const n = src.read(block, BLOCK_SIZE); n < BLOCK_SIZE)
+                block[n] = 128;     // marker początku 'uzupełnienia'
+
+            u32 words[2];
+            load_le32(block, words);
+            words[0] ^= chain[0];
+            words[1] ^= chain[1];
+            encrypt_block(words, words);
+            if (cbc) {
+                chain[0] = words[0];
+                chain[1] = words[1];
+            }
+            store_le32(block, words);
+            dst.write(block, BLOCK_SIZE);
+        }
+        return out_size;
+    }
+
+    size_t blowfish::decrypt_fragments(const_fragments const in, fragments const out, bool const cbc) const noexcept {
+        auto nbytes = total_size(in);
+        if (nbytes % BLOCK_SIZE || nbytes < (cbc ? 2 : 1) * BLOCK_SIZE)
+            return 0;
+        // Miejsce sprawdzamy przed odszyfrowaniem czegokolwiek (jak w encrypt_fragments),
+        // aby przy zbyt małym 'out' nie zostawiać w nim części jawnego tekstu.
+        if (total_size(out) < nbytes - (cbc ? BLOCK_SIZE : 0))
+            return 0;
+
+        gather src{in};
+        scatter dst{out};
+
+        u8 block[BLOCK_SIZE];
+        u32 chain[2]{};
+        if (cbc) {
+            src.read(block, BLOCK_SIZE);
+            load_le32(block, chain);
+            nbytes -= BLOCK_SIZE;
+        }
+
+        auto const blocks = nbytes / BLOCK_SIZE;
+        size_t written = 0;
+        for (size_t i = 0; i < blocks; ++i) {
+            u32 words[2];
+            src.read(block, BLOCK_SIZE);
+            load_le32(block, words);
+            u32 const next[2]{words[0], words[1]};
+            decrypt_block(words, words);
+            words[0] ^= chain[0];
+            words[1] ^= chain[1];
+            if (cbc) {
+                chain[0] = next[0];
+                chain[1] = next[1];
+            }
+            store_le32(block, words);
+
+            // W ostatnim bloku obcinamy 'ogon'.
+            auto n = BLOCK_SIZE;
+            if (i + 1 == blocks)
+                if (int const idx = padding_index(block, BLOCK_SIZE); idx != -1)
+                    n = static_cast<size_t>(idx);
+
+            if (!dst.write(block, n)) {
+                secure_zero(block, sizeof(block));
+                return 0;
+            }
+            written += n;
+        }
+        secure_zero(block, sizeof(block));
+        return written;
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                     O F B  /  C F B                           *
+    *                                                               *
+    ****************************************************************/
+
+    auto blowfish::encrypt_ofb(void const* const data, size_t const nbytes, void const* const iv) const noexcept
+    -> std::vector<u8>
+    {
+        return stream::encrypt(*this, stream::ofb<blowfish>, data, nbytes, iv);
+    }
+
+    auto blowfish::decrypt_ofb(void const* const cipher, size_t const nbytes) const noexcept
+    -> std::vector<u8>
+    {
+        return stream::decrypt(*this, stream::ofb<blowfish>, cipher, nbytes);
+    }
+
+    auto blowfish::encrypt_cfb(void const* const data, size_t const nbytes, void const* const iv) const noexcept
+    -> std::vector<u8>
+    {
+        return stream::encrypt(*this, stream::cfb_encrypt<blowfish>, data, nbytes, iv);
+    }
+
+    auto blowfish::decrypt_cfb(void const* const cipher, size_t const nbytes) const noexcept
+    -> std::vector<u8>
+    {
+        return stream::decrypt(*this, stream::cfb_decrypt<blowfish>, cipher, nbytes);
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                 e n c r y p t _ l a n e s                     *
+    *                                                               *
+    ****************************************************************/
+
+    // Szyfrowanie LANES niezależnych bloków z przeplotem rund,
+    // aby odczyty z tablic s różnych bloków nakładały się w czasie.
+    void blowfish::encrypt_lanes(u32 (&xl)[LANES], u32 (&xr)[LANES]) const noexcept {
+        assert(ks_ && "blowfish: use of a moved-from object");
+        auto const& p = ks_->p;
+
+        for (size_t r = 0; r < ROUND_COUNT; r += 2) {
+            for (size_t i = 0; i < LANES; ++i) {
+                xl[i] ^= p[r];
+                xr[i] ^= f(xl[i]);
+            }
+            for (size_t i = 0; i < LANES; ++i) {
+                xr[i] ^= p[r + 1];
+                xl[i] ^= f(xr[i]);
+            }
+        }
+        for (size_t i = 0; i < LANES; ++i) {
+            auto const t = xl[i];
+            xl[i] = xr[i] ^ p[17];
+            xr[i] = t ^ p[16];
+        }
+    }
+
+    /****************************************************************
+    *                                                               *
+    *              e n c r y p t _ c b c _ b a t c h                *
+    *                                                               *
+    ****************************************************************/
+
+    auto blowfish::encrypt_cbc_batch(std::span<std::span<u8 const> const> const messages) const
+    -> batch
+    {
+        batch result{};
+        result.offsets.reserve(messages.size() + 1);
+
+        // Rozmiary szyfrogramów (IV + dane z 'uzupełnieniem'); pusta wiadomość daje pusty szyfrogram.
+        size_t total = 0;
+        result.offsets.push_back(0);
+        for (auto const& msg : messages) {
+            if (!msg.empty())
+                total += BLOCK_SIZE + (msg.size() + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+            result.offsets.push_back(total);
+        }
+        if (total == 0)
+            return result;
+        result.data.resize(total);
+
+        // Wszystkie wektory IV jednym wywołaniem generatora.
+        std::vector<u8> ivs(messages.size() * BLOCK_SIZE);
+        box::fill_random(ivs.data(), ivs.size());
+
+        // Stan toru: wiadomość, pozycja w niej i poprzedni blok szyfrogramu.
+        struct lane {
+            size_t msg;
+            size_t pos;
+            u8* dst;
+            bool active;
+        } lanes[LANES]{};
+        u32 xl[LANES]{}, xr[LANES]{};
+
+        size_t next = 0;
+        auto const assign = [&](lane& ln, size_t const i) {
+            while (next < messages.size() && messages[next].empty())
+                ++next;
+            if (next == messages.size()) {
+                ln.active = false;
+                return;
+            }
+            ln = lane{next, 0, result.data.data() + result.offsets[next], true};
+            std::memcpy(ln.dst, ivs.data() + next * BLOCK_SIZE, BLOCK_SIZE);
+            xl[i] = load_le32(ln.dst);
+            xr[i] = load_le32(ln.dst + sizeof(u32));
+            ln.dst += BLOCK_SIZE;
+            ++next;
+        };
+        for (size_t i = 0; i < LANES; ++i)
+            assign(lanes[i], i);
+
+        // Wspólny bufor na blok jawnego tekstu, zerowany raz po zakończeniu.
+        u8 block[BLOCK_SIZE];
+        for (;;) {
+            bool any = false;
+            for (size_t i = 0; i < LANES; ++i) {
+                auto& ln = lanes[i];
+                if (!ln.active)
+                    continue;
+                any = true;
+
+                // Blok jawnego tekstu; ostatni niepełny blok uzupełniamy markerem 128 i zerami.
+                auto const& msg = messages[ln.msg];
+                std::memset(block, 0, BLOCK_SIZE);
+                auto const n = std::min(BLOCK_SIZE, msg.size() - ln.pos);
+                std::memcpy(block, msg.data() + ln.pos, n);
+                if (n < BLOCK_SIZE)
+                    block[n] = 128;
+
+                xl[i] ^= load_le32(block);
+                xr[i] ^= load_le32(block + sizeof(u32));
+            }
+            if (!any)
+                break;
+
+            encrypt_lanes(xl, xr);
+
+            for (size_t i = 0; i < LANES; ++i) {
+                auto& ln = lanes[i];
+                if (!ln.active)
+                    continue;
+                store_le32(ln.dst, xl[i]);
+                store_le32(ln.dst + sizeof(u32), xr[i]);
+                ln.dst += BLOCK_SIZE;
+                ln.pos += BLOCK_SIZE;
+                if (ln.pos >= messages[ln.msg].size())
+                    assign(ln, i);
+            }
+        }
+        secure_zero(block, sizeof(block));
+
+        return result;
+    }
 }
@@ -4,8 +4,14 @@
 
 #pragma once
 #include "../../types.h"
+#include "../arena/arena.h"
+#include "../iovec/iovec.h"
 #include <utility>  // for std::pair
 #include <memory>   // for std::shared_ptr
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
 #include <vector>
 
 
@@ -16,12 +22,54 @@ namespace bee::crypto {
         static constexpr size_t KEY_MINSIZE = 4;
         static constexpr size_t KEY_MAXSIZE = 56;
 
-        u32 p[ROUND_COUNT + 2]{};
-        u32 s[4][256]{};
+        // Format bloba z rozwiniętym kluczem (schedule):
+        // magic (4) | wersja (4) | p[18] | s[4][256] | tag (8),
+        // wszystkie liczby zapisane jako little-endian.
+        static constexpr u32 SCHEDULE_MAGIC = 0x534b4642;   // "BFKS"
+        static constexpr u32 SCHEDULE_VERSION = 1;
+        static constexpr size_t SCHEDULE_HEADER_SIZE = 2 * sizeof(u32);
+        static constexpr size_t SCHEDULE_TABLES_SIZE = (ROUND_COUNT + 2 + 4 * 256) * sizeof(u32);
+        static constexpr size_t SCHEDULE_TAG_SIZE = sizeof(u64);
+        static constexpr size_t SCHEDULE_SIZE = SCHEDULE_HEADER_SIZE + SCHEDULE_TABLES_SIZE + SCHEDULE_TAG_SIZE;
+
+        // Tablice rozwiniętego klucza trzymamy w zablokowanej pamięci (arena),
+        // która jest zerowana przy zwalnianiu obiektu.
+        struct schedule {
+            u32 p[ROUND_COUNT + 2];
+            u32 s[4][256];
+        };
+        secure_ptr<schedule> ks_;
+
+        blowfish() : ks_{make_secure<schedule>()} {}
     public:
         blowfish(void const* key_material, size_t key_size);
         explicit blowfish(BytesView auto const key) : blowfish(key.data(), key.size()) {};
-        ~blowfish();
+        /// Obiekt, z którego przeniesiono klucz, nie ma tablic - wolno go tylko
+        /// zniszczyć lub przypisać mu nowy obiekt (inne metody kończą się asercją).
+        blowfish(blowfish&&) noexcept = default;
+        blowfish& operator=(blowfish&&) noexcept = default;
+
+        /// Eksport rozwiniętego klucza (tablice p i s) do binarnego bloba.
+        /// Blob jest równoważny kluczowi - należy go przechowywać w chronionym miejscu,
+        /// dlatego zwracamy go w pamięci zablokowanej i zerowanej przy zwalnianiu.
+        /// \return Blob o rozmiarze schedule_size() z wersją i sumą kontrolną.
+        [[nodiscard]] auto export_schedule() const noexcept
+        -> secure_bytes;
+
+        /// Utworzenie obiektu z bloba utworzonego przez export_schedule().
+        /// Rozwijanie klucza jest całkowicie pomijane.
+        /// Suma kontrolna (FNV-1a bez klucza) wykrywa tylko przypadkowe uszkodzenie bloba;
+        /// nie chroni przed celową modyfikacją - blob musi pochodzić z zaufanego źródła.
+        /// \return Obiekt szyfru lub nic, jeśli blob jest niepoprawny (wersja, rozmiar, tag).
+        static auto from_schedule(void const*, size_t) noexcept
+        -> std::optional<blowfish>;
+
+        static auto from_schedule(BytesView auto const blob) noexcept
+        -> std::optional<blowfish> {
+            return from_schedule(blob.data(), blob.size());
+        }
+
+        static auto schedule_size() noexcept { return SCHEDULE_SIZE; }
 
         [[nodiscard]] static size_t key_maxsize() noexcept { return KEY_MAXSIZE; }
         [[nodiscard]] static size_t key_minsize() noexcept { return KEY_MINSIZE; }
@@ -49,12 +97,96 @@ namespace bee::crypto {
         auto decrypt_cbc(void const*, size_t) const noexcept
         -> std::vector<u8>;
 
+        /// Szyfrowanie ECB/CBC danych złożonych z wielu fragmentów (scatter-gather),
+        /// bez wcześniejszego sklejania ich w jeden bufor. Bloki mogą przekraczać
+        /// granice fragmentów. Wynik jest identyczny z wersjami dla ciągłego bufora.
+        /// \return Liczba zapisanych bajtów lub 0, jeśli brak danych lub miejsca w 'out'.
+        auto encrypt_ecb(const_fragments in, fragments out) const noexcept
+        -> size_t {
+            return encrypt_fragments(in, out, false, nullptr);
+        }
+
+        auto encrypt_cbc(const_fragments in, fragments out, void const* iv = nullptr) const noexcept
+        -> size_t {
+            return encrypt_fragments(in, out, true, iv);
+        }
+
+        /// Odszyfrowanie ECB/CBC z fragmentów do fragmentów.
+        /// 'out' musi pomieścić cały szyfrogram bez IV (także 'uzupełnienie').
+        /// \return Liczba bajtów jawnego tekstu (bez 'uzupełnienia') lub 0 w przypadku błędu.
+        auto decrypt_ecb(const_fragments in, fragments out) const noexcept
+        -> size_t {
+            return decrypt_fragments(in, out, false);
+        }
+
+        auto decrypt_cbc(const_fragments in, fragments out) const noexcept
+        -> size_t {
+            return decrypt_fragments(in, out, true);
+        }
+
+        /// Szyfrowanie w trybie OFB. Szyfrogram (bez 'uzupełnienia') poprzedzony jest wektorem IV.
+        /// \param iv Wektor IV (BLOCK_SIZE bajtów) lub nullptr, wtedy IV jest losowany.
+        auto encrypt_ofb(void const*, size_t, void const* = nullptr) const noexcept
+        -> std::vector<u8>;
+
+        auto decrypt_ofb(void const*, size_t) const noexcept
+        -> std::vector<u8>;
+
+        /// Szyfrowanie w trybie CFB (64-bitowym). Szyfrogram poprzedzony jest wektorem IV.
+        auto encrypt_cfb(void const*, size_t, void const* = nullptr) const noexcept
+        -> std::vector<u8>;
+
+        auto decrypt_cfb(void const*, size_t) const noexcept
+        -> std::vector<u8>;
+
+        /// Wynik szyfrowania wsadowego: wszystkie szyfrogramy w jednym buforze.
+        /// Szyfrogram i-tej wiadomości (IV + dane, jak z encrypt_cbc) zajmuje
+        /// bajty od offsets[i] do offsets[i+1].
+        struct batch {
+            std::vector<u8> data;
+            std::vector<size_t> offsets;
+
+            [[nodiscard]] size_t size() const noexcept { return offsets.empty() ? 0 : offsets.size() - 1; }
+            [[nodiscard]] std::span<u8 const> operator[](size_t const i) const noexcept {
+                return {data.data() + offsets[i], offsets[i + 1] - offsets[i]};
+            }
+        };
+
+        /// Szyfrowanie CBC wielu wiadomości jednym wywołaniem.
+        /// Wektory IV losowane są hurtowo, a bloki różnych wiadomości
+        /// są przeplatane, aby niezależne łańcuchy CBC wypełniały potok procesora.
+        /// Każdy szyfrogram można odszyfrować przez decrypt_cbc.
+        auto encrypt_cbc_batch(std::span<std::span<u8 const> const>) const
+        -> batch;
+
+        /// Wiadomości muszą być ciągłymi zakresami bajtów (np. std::string, std::vector<u8>) -
+        /// rozmiar wiadomości to liczba jej elementów.
+        template<std::ranges::input_range R, typename M = std::ranges::range_value_t<R>>
+            requires std::ranges::contiguous_range<M const> && std::ranges::sized_range<M const>
+                     && (sizeof(std::ranges::range_value_t<M>) == 1)
+                     && std::is_trivially_copyable_v<std::ranges::range_value_t<M>>
+        auto encrypt_cbc_batch(R const& messages) const
+        -> batch {
+            std::vector<std::span<u8 const>> spans;
+            for (auto const& msg : messages)
+                spans.emplace_back(reinterpret_cast<u8 const*>(std::ranges::data(msg)), std::ranges::size(msg));
+            return encrypt_cbc_batch(std::span<std::span<u8 const> const>{spans});
+        }
+
         static auto key_min_size() noexcept { return KEY_MINSIZE; }
         static auto key_max_size() noexcept { return KEY_MAXSIZE; }
         static auto block_size() noexcept { return BLOCK_SIZE; }
 
     private:
+        friend class multi_buffer;
+
+        static constexpr size_t LANES = 4;
+        void encrypt_lanes(u32 (&xl)[LANES], u32 (&xr)[LANES]) const noexcept;
+        size_t encrypt_fragments(const_fragments, fragments, bool cbc, void const* iv) const noexcept;
+        size_t decrypt_fragments(const_fragments, fragments, bool cbc) const noexcept;
+
         [[nodiscard]] u32 f(u32 x) const noexcept {
+            auto const& s = ks_->s;
             u32 const d = x & 0x00ff; x >>= 8;
             u32 const c = x & 0x00ff; x >>= 8;
             u32 const b = x & 0x00ff; x >>= 8;
@@ -0,0 +1,146 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#include "multi_buffer.h"
+#include "../crypto.h"
+#include <cassert>
+
+namespace bee::crypto {
+    bool multi_buffer::encrypt(std::span<job const> const jobs) noexcept {
+        if (!valid(jobs))
+            return false;
+        process<true>(jobs);
+        return true;
+    }
+
+    bool multi_buffer::decrypt(std::span<job const> const jobs) noexcept {
+        if (!valid(jobs))
+            return false;
+        process<false>(jobs);
+        return true;
+    }
+
+    bool multi_buffer::valid(std::span<job const> const jobs) noexcept {
+        for (auto const& j : jobs)
+            if (!j.cipher || j.nbytes % BLOCK_SIZE || (j.nbytes && (!j.src || !j.dst)))
+                return false;
+        return true;
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                       p r o c e s s                           *
+    *                                                               *
+    ****************************************************************/
+
+    template<bool Encrypt>
+    void multi_buffer::process(std::span<job const> const jobs) noexcept {
+        // Stan toru: pozycja w danych i poprzedni blok (CBC); tablice klucza zadania
+        // są w osobnych tablicach p i s, żeby pętla rund czytała je bez pośrednictwa.
+        // Aktywne tory trzymamy na początku tablic, więc pętla rund nie sprawdza,
+        // czy tor ma jeszcze dane.
+        struct lane {
+            u8 const* src;
+            u8* dst;
+            size_t left;
+            u32 chain[2];
+            bool cbc;
+        } lanes[LANES];
+        u32 const* p[LANES];
+        u32 const (*s[LANES])[256];
+        u32 xl[LANES], xr[LANES];
+
+        size_t next = 0;
+        auto const assign = [&](size_t const i) {
+            while (next < jobs.size() && jobs[next].nbytes == 0)
+                ++next;
+            if (next == jobs.size())
+                return false;
+            auto const& j = jobs[next++];
+            assert(j.cipher->ks_ && "blowfish: use of a moved-from object");
+            auto const& ks = *j.cipher->ks_;
+            p[i] = ks.p;
+            s[i] = ks.s;
+            auto& ln = lanes[i];
+            ln = lane{static_cast<u8 const*>(j.src), static_cast<u8*>(j.dst), j.nbytes, {}, j.iv != nullptr};
+            if (ln.cbc)
+                load_le32(j.iv, ln.chain);
+            return true;
+        };
+
+        size_t count = 0;
+        while (count < LANES && assign(count))
+            ++count;
+
+        auto const f = [](u32 const (*sbox)[256], u32 const x) {
+            return ((sbox[0][x >> 24] + sbox[1][(x >> 16) & 0xff]) ^ sbox[2][(x >> 8) & 0xff]) + sbox[3][x & 0xff];
+        };
+
+        while (count) {
+            for (size_t i = 0; i < count; ++i) {
+                auto const& ln = lanes[i];
+                xl[i] = load_le32(ln.src);
+                xr[i] = load_le32(ln.src + sizeof(u32));
+                if (Encrypt && ln.cbc) {
+                    xl[i] ^= ln.chain[0];
+                    xr[i] ^= ln.chain[1];
+                }
+            }
+
+            // Rundy jak w encrypt_block/decrypt_block, ale dla wszystkich torów naraz.
+            for (size_t r = 0; r < 16; r += 2) {
+                for (size_t i = 0; i < count; ++i) {
+                    xl[i] ^= p[i][Encrypt ? r : 17 - r];
+                    xr[i] ^= f(s[i], xl[i]);
+                }
+                for (size_t i = 0; i < count; ++i) {
+                    xr[i] ^= p[i][Encrypt ? r + 1 : 16 - r];
+                    xl[i] ^= f(s[i], xr[i]);
+                }
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                auto& ln = lanes[i];
+                u32 out[2]{
+                    xr[i] ^ p[i][Encrypt ? 17 : 0],
+                    xl[i] ^ p[i][Encrypt ? 16 : 1]
+                };
+                if (ln.cbc) {
+                    if constexpr (Encrypt) {
+                        ln.chain[0] = out[0];
+                        ln.chain[1] = out[1];
+                    } else {
+                        // src i dst mogą być tym samym buforem - blok szyfrogramu czytamy przed zapisem.
+                        u32 cipher[2];
+                        load_le32(ln.src, cipher);
+                        out[0] ^= ln.chain[0];
+                        out[1] ^= ln.chain[1];
+                        ln.chain[0] = cipher[0];
+                        ln.chain[1] = cipher[1];
+                    }
+                }
+                store_le32(ln.dst, out);
+                ln.src += BLOCK_SIZE;
+                ln.dst += BLOCK_SIZE;
+                ln.left -= BLOCK_SIZE;
+            }
+
+            // Tory, które skończyły: nowe zadanie albo przeniesienie ostatniego aktywnego toru.
+            for (size_t i = 0; i < count;) {
+                if (lanes[i].left || assign(i)) {
+                    ++i;
+                    continue;
+                }
+                --count;
+                lanes[i] = lanes[count];
+                p[i] = p[count];
+                s[i] = s[count];
+            }
+        }
+
+        secure_zero(lanes, sizeof(lanes));
+        secure_zero(xl, sizeof(xl));
+        secure_zero(xr, sizeof(xr));
+    }
+}
@@ -0,0 +1,40 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#pragma once
+#include "blowfish.h"
+#include <span>
+
+namespace bee::crypto {
+    /// Równoległe przetwarzanie wielu niezależnych strumieni, każdy z własnym kluczem
+    /// (np. sesje różnych klientów bramy szyfrujące krótkie pakiety).
+    /// Rundy bloków z różnych zadań są przeplatane w jednej pętli, dzięki czemu
+    /// procesor wykonuje równolegle odczyty tablic S kilku strumieni.
+    /// Tor, który skończył swoje zadanie, od razu dostaje kolejne z listy.
+    class multi_buffer final {
+        static constexpr size_t BLOCK_SIZE = 8;
+    public:
+        static constexpr size_t LANES = 8;
+
+        /// Zadanie: dane bez 'uzupełnienia' (nbytes musi być wielokrotnością bloku),
+        /// src i dst mogą wskazywać ten sam bufor.
+        /// Jeśli iv == nullptr, dane są przetwarzane w trybie ECB, w przeciwnym razie CBC
+        /// (IV nie jest zapisywany do dst).
+        struct job {
+            blowfish const* cipher;
+            void const* src;
+            void* dst;
+            size_t nbytes;
+            void const* iv{};
+        };
+
+        /// \return FALSE, jeśli któreś zadanie jest niepoprawne (wtedy nic nie jest przetwarzane).
+        static bool encrypt(std::span<job const> jobs) noexcept;
+        static bool decrypt(std::span<job const> jobs) noexcept;
+    private:
+        static bool valid(std::span<job const> jobs) noexcept;
+        template<bool Encrypt>
+        static void process(std::span<job const> jobs) noexcept;
+    };
+}
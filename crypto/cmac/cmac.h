@@ -0,0 +1,236 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#pragma once
+#include "../crypto.h"
+#include "../../csprng.h"
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+namespace bee::crypto {
+    /// CMAC (NIST SP 800-38B) dla szyfrów o 64-bitowym bloku.
+    /// Dane można podawać w kolejnych porcjach (update), tag zwraca final.
+    template<typename Cipher>
+    class cmac final {
+        static constexpr size_t BLOCK_SIZE = 8;
+        static constexpr u64 RB = 0x1b;
+
+        Cipher const& cipher_;
+        u8 k1_[BLOCK_SIZE]{};
+        u8 k2_[BLOCK_SIZE]{};
+        u32 state_[2]{};
+        u8 pending_[BLOCK_SIZE]{};
+        size_t pending_size_{};
+    public:
+        static constexpr size_t TAG_SIZE = BLOCK_SIZE;
+
+        /// \param cipher Szyfr (musi istnieć dłużej niż obiekt cmac).
+        explicit cmac(Cipher const& cipher) noexcept : cipher_{cipher} {
+            // Podklucze: L = E(0), K1 = L·x, K2 = L·x² w GF(2^64).
+            u32 l[2]{};
+            cipher_.encrypt_block(l, l);
+            u8 bytes[BLOCK_SIZE];
+            store_le32(bytes, l);
+            double_block(bytes, k1_);
+            double_block(k1_, k2_);
+            secure_zero(l, sizeof(l));
+            secure_zero(bytes, sizeof(bytes));
+        }
+
+        ~cmac() {
+            secure_zero(k1_, sizeof(k1_));
+            secure_zero(k2_, sizeof(k2_));
+            secure_zero(state_, sizeof(state_));
+            secure_zero(pending_, sizeof(pending_));
+        }
+
+        // Obiekt tymczasowy zniknąłby przed pierwszym użyciem.
+        explicit cmac(Cipher&&) = delete;
+        cmac(cmac const&) = delete;
+        cmac& operator=(cmac const&) = delete;
+
+        void update(void const* const data, size_t nbytes) noexcept {
+            auto ptr = static_cast<u8 const*>(data);
+            while (nbytes) {
+                // Ostatni blok musi czekać na final (podklucz K1/K2),
+                // więc pełny blok przetwarzamy dopiero, gdy przychodzą kolejne dane.
+                if (pending_size_ == BLOCK_SIZE) {
+                    absorb(pending_);
+                    pending_size_ = 0;
+                }
+                auto const n = std::min(nbytes, BLOCK_SIZE - pending_size_);
+                std::memcpy(pending_ + pending_size_, ptr, n);
+                pending_size_ += n;
+                ptr += n;
+                nbytes -= n;
+            }
+        }
+
+        /// Dodanie pełnego bloku, o którym wiadomo, że nie jest ostatnim.
+        void update_block(u8 const* const block) noexcept {
+            if (pending_size_ == BLOCK_SIZE)
+                absorb(pending_);
+            std::memcpy(pending_, block, BLOCK_SIZE);
+            pending_size_ = BLOCK_SIZE;
+        }
+
+        /// Zakończenie i zapis tagu (TAG_SIZE bajtów).
+        void final(u8* const tag) noexcept {
+            u8 last[BLOCK_SIZE]{};
+            std::memcpy(last, pending_, pending_size_);
+            u8 const* key = k1_;
+            if (pending_size_ < BLOCK_SIZE) {
+                last[pending_size_] = 0x80;
+                key = k2_;
+            }
+            for (size_t i = 0; i < BLOCK_SIZE; ++i)
+                last[i] ^= key[i];
+            absorb(last);
+            store_le32(tag, state_);
+
+            state_[0] = state_[1] = 0;
+            pending_size_ = 0;
+        }
+
+    private:
+        void absorb(u8 const* const block) noexcept {
+            u32 words[2];
+            load_le32(block, words);
+            state_[0] ^= words[0];
+            state_[1] ^= words[1];
+            cipher_.encrypt_block(state_, state_);
+        }
+
+        // Mnożenie przez x: przesunięcie ciągu bitów (big-endian) w lewo o 1.
+        static void double_block(u8 const* const src, u8* const dst) noexcept {
+            u64 v = 0;
+            for (size_t i = 0; i < BLOCK_SIZE; ++i)
+                v = v << 8 | src[i];
+            v = (v << 1) ^ ((v >> 63) * RB);
+            for (size_t i = 0; i < BLOCK_SIZE; ++i)
+                dst[BLOCK_SIZE - 1 - i] = static_cast<u8>(v >> (8 * i));
+        }
+    };
+
+    /// Szyfrowanie z uwierzytelnieniem w jednym przebiegu: CBC + CMAC (encrypt-then-MAC).
+    /// Każdy blok szyfrogramu trafia do CMAC w tej samej pętli, w której powstaje,
+    /// a przy odszyfrowaniu tag jest liczony w pętli odszyfrowującej.
+    /// Format: IV | szyfrogram CBC | tag (8 bajtów); tag obejmuje IV i szyfrogram.
+    /// 'Uzupełnienie' to zawsze 0x80 i zera (ISO/IEC 7816-4), także dla pełnych bloków.
+    /// Szyfry do danych i do MAC muszą mieć różne klucze.
+    template<typename Cipher>
+    class authenticated final {
+        static constexpr size_t BLOCK_SIZE = 8;
+
+        Cipher const& cipher_;
+        Cipher const& mac_;
+    public:
+        static constexpr size_t TAG_SIZE = cmac<Cipher>::TAG_SIZE;
+
+        /// \param cipher Szyfr dla danych (musi istnieć dłużej niż obiekt authenticated),
+        /// \param mac Szyfr dla CMAC (musi istnieć dłużej niż obiekt authenticated).
+        authenticated(Cipher const& cipher, Cipher const& mac) noexcept
+            : cipher_{cipher}, mac_{mac} {}
+
+        // Obiekty tymczasowe zniknęłyby przed pierwszym użyciem.
+        authenticated(Cipher&&, Cipher const&) = delete;
+        authenticated(Cipher const&, Cipher&&) = delete;
+        authenticated(Cipher&&, Cipher&&) = delete;
+
+        /// \param iv Wektor IV (BLOCK_SIZE bajtów) lub nullptr, wtedy IV jest losowany.
+        /// \return IV + szyfrogram + tag.
+        auto encrypt(void const* const data, size_t const nbytes, void const* const iv = nullptr) const noexcept
+        -> std::vector<u8>
+        {
+            auto const size = (nbytes / BLOCK_SIZE + 1) * BLOCK_SIZE;
+            std::vector<u8> out(BLOCK_SIZE + size + TAG_SIZE);
+            if (iv)
+                std::memcpy(out.data(), iv, BLOCK_SIZE);
+            else
+                csprng::instance().fill(out.data(), BLOCK_SIZE);
+
+            cmac<Cipher> mac{mac_};
+            mac.update_block(out.data());
+
+            u32 chain[2];
+            load_le32(out.data(), chain);
+            auto const src = static_cast<u8 const*>(data);
+            auto dst = out.data() + BLOCK_SIZE;
+            for (size_t pos = 0; pos < size; pos += BLOCK_SIZE) {
+                u8 block[BLOCK_SIZE]{};
+                if (pos + BLOCK_SIZE <= nbytes)
+                    std::memcpy(block, src + pos, BLOCK_SIZE);
+                else {
+                    if (pos < nbytes)
+                        std::memcpy(block, src + pos, nbytes - pos);
+                    block[nbytes - pos] = 0x80;
+                }
+                u32 words[2];
+                load_le32(block, words);
+                chain[0] ^= words[0];
+                chain[1] ^= words[1];
+                cipher_.encrypt_block(chain, chain);
+                store_le32(dst, chain);
+                mac.update_block(dst);
+                secure_zero(block, sizeof(block));
+                dst += BLOCK_SIZE;
+            }
+            mac.final(dst);
+            return out;
+        }
+
+        /// Odszyfrowanie i weryfikacja tagu w jednym przebiegu.
+        /// \return Jawny tekst lub nic, jeśli tag się nie zgadza lub dane są uszkodzone.
+        auto decrypt(void const* const data, size_t const nbytes) const noexcept
+        -> std::optional<std::vector<u8>>
+        {
+            if (!data || nbytes < 2 * BLOCK_SIZE + TAG_SIZE || (nbytes - TAG_SIZE) % BLOCK_SIZE)
+                return {};
+
+            auto const src = static_cast<u8 const*>(data);
+            auto const size = nbytes - TAG_SIZE - BLOCK_SIZE;
+            std::vector<u8> plain(size);
+
+            cmac<Cipher> mac{mac_};
+            mac.update_block(src);
+
+            u32 chain[2];
+            load_le32(src, chain);
+            for (size_t pos = 0; pos < size; pos += BLOCK_SIZE) {
+                auto const block = src + BLOCK_SIZE + pos;
+                mac.update_block(block);
+
+                u32 words[2];
+                load_le32(block, words);
+                u32 const next[2]{words[0], words[1]};
+                cipher_.decrypt_block(words, words);
+                words[0] ^= chain[0];
+                words[1] ^= chain[1];
+                store_le32(plain.data() + pos, words);
+                chain[0] = next[0];
+                chain[1] = next[1];
+            }
+
+            u8 tag[TAG_SIZE];
+            mac.final(tag);
+            // Porównanie w czasie niezależnym od miejsca różnicy.
+            u8 diff = 0;
+            for (size_t i = 0; i < TAG_SIZE; ++i)
+                diff |= tag[i] ^ src[nbytes - TAG_SIZE + i];
+
+            // Usunięcie 'uzupełnienia': ostatni niezerowy bajt musi być markerem 0x80.
+            size_t end = size;
+            while (end > size - BLOCK_SIZE && plain[end - 1] == 0)
+                --end;
+            if (diff != 0 || end == size - BLOCK_SIZE || plain[end - 1] != 0x80) {
+                secure_zero(plain.data(), plain.size());
+                return {};
+            }
+            plain.resize(end - 1);
+            return plain;
+        }
+    };
+}
@@ -3,7 +3,6 @@
 //
 
 #include "crypto.h"
-#include "../toolbox.h"
 #include <cstring>
 
 namespace bee::crypto {
@@ -19,15 +18,36 @@ namespace bee::crypto {
         return -1;
     }
 
-    void clear_bytes(void* const data, size_t const nbytes) noexcept {
-        // czterokrotnie wypełniamy bufor liczbami losowymi
-        for (auto i = 0; i < 4; ++i) {
-            const auto rnd = box::random_bytes<u8>(nbytes);
-            std::memcpy(data, rnd.data(), nbytes);
+    namespace {
+        void fill(void* const data, int const pattern, size_t const nbytes) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            std::memset(data, pattern, nbytes);
+            // Bariera dla kompilatora: pamięć wskazywana przez 'data' jest "używana",
+            // więc memset nie może zostać usunięty jako martwy zapis.
+            __asm__ __volatile__("" : : "r"(data) : "memory");
+#else
+            auto ptr = static_cast<u8 volatile*>(data);
+            for (size_t i = 0; i < nbytes; ++i)
+                ptr[i] = static_cast<u8>(pattern);
+#endif
         }
-        std::memset(data, 0x55, nbytes);
-        std::memset(data, 0xaa, nbytes);
-        std::memset(data, 0xff, nbytes);
-        std::memset(data, 0x00, nbytes);
+    }
+
+    // Zerowanie pamięci, którego kompilator nie może pominąć.
+    void secure_zero(void* const data, size_t const nbytes) noexcept {
+        if (data && nbytes)
+            fill(data, 0x00, nbytes);
+    }
+
+    void clear_bytes(void* const data, size_t const nbytes, wipe_policy const policy) noexcept {
+        if (!data || nbytes == 0)
+            return;
+
+        if (policy == wipe_policy::multi_pass) {
+            fill(data, 0x55, nbytes);
+            fill(data, 0xaa, nbytes);
+            fill(data, 0xff, nbytes);
+        }
+        fill(data, 0x00, nbytes);
     }
 }
@@ -4,10 +4,26 @@
 
 #pragma once
 #include "../types.h"
-#include "blowfish/blowfish.h"
-#include "gost/gost.h"
 
 namespace bee::crypto {
+    /// Sposób czyszczenia pamięci z wrażliwymi danymi.
+    enum class wipe_policy {
+        zero,       // jednokrotne zerowanie
+        multi_pass, // kilka przebiegów wzorcami (0x55, 0xaa, 0xff), na końcu zera
+    };
+
     int padding_index(u8 const*, int) noexcept;
-    void clear_bytes(void*, size_t) noexcept;
+    void secure_zero(void*, size_t) noexcept;
+    void clear_bytes(void*, size_t, wipe_policy = wipe_policy::zero) noexcept;
 }
+
+// Moduły dołączamy po deklaracjach powyżej - szablony trybów z nich korzystają.
+#include "blowfish/blowfish.h"
+#include "blowfish/multi_buffer.h"
+#include "gost/gost.h"
+#include "xts/xts.h"
+#include "xts/sector_file.h"
+#include "stream/stream.h"
+#include "stream/keystream.h"
+#include "cmac/cmac.h"
+#include "kdf/kdf.h"
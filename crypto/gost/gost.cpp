@@ -4,13 +4,18 @@
 
 #include "gost.h"
 #include "../crypto.h"
+#include "../stream/stream.h"
 #include <iostream>
+#include <algorithm>
+#include <cassert>
 #include <cstring>
 #include <format>
 
 namespace bee::crypto {
 
-    gost::gost(void const* const key_material, size_t const key_size) {
+    gost::gost(void const* const key_material, size_t const key_size)
+        : ks_{make_secure<tables>()}
+    {
         if (key_size != KEY_SIZE) {
             std::cerr << std::format("Key size must be equal to {}bytes\n", KEY_SIZE);
             // return;
@@ -25,7 +30,8 @@ namespace bee::crypto {
         static const u8 k2[16] = { 4, 11, 2, 14, 15, 0, 8, 13, 3, 12, 9, 7, 5, 10, 6, 1 };
         static const u8 k1[16] =  {13, 2, 8, 4, 6, 15, 11, 1, 10, 9, 3, 14, 5, 0, 12, 7 };
 
-        std::memcpy(k, key_material, key_size);
+        auto& [k, k87, k65, k43, k21] = *ks_;
+        std::memcpy(k, key_material, std::min(key_size, sizeof(k)));
 
         for (int i = 0; i < 256; i++) {
             const int p1 = i >> 4;
@@ -37,15 +43,9 @@ namespace bee::crypto {
         }
     }
 
-    gost::~gost() {
-        clear_bytes(k, 8 * sizeof(u32));
-        clear_bytes(k87, 256);
-        clear_bytes(k65, 256);
-        clear_bytes(k43, 256);
-        clear_bytes(k21, 256);
-    }
-
     void gost::encrypt_block(u32 const* const src, u32* const dst) const noexcept {
+        assert(ks_ && "gost: use of a moved-from object");
+        auto const& k = ks_->k;
         u32 n1 = src[0];
         u32 n2 = src[1];
 
@@ -74,6 +74,8 @@ namespace bee::crypto {
     }
 
     void gost::decrypt_block(u32 const* const src, u32* const dst) const noexcept {
+        assert(ks_ && "gost: use of a moved-from object");
+        auto const& k = ks_->k;
         u32 n1 = src[0];
         u32 n2 = src[1];
 
@@ -101,5 +103,33 @@ namespace bee::crypto {
         dst[1] = n1;
     }
 
+    /****************************************************************
+    *                                                               *
+    *                     O F B  /  C F B                           *
+    *                                                               *
+    ****************************************************************/
 
-}
\ No newline at end of file
+    auto gost::encrypt_ofb(void const* const data, size_t const nbytes, void const* const iv) const noexcept
+    -> std::vector<u8>
+    {
+        return stream::encrypt(*this, stream::ofb<gost>, data, nbytes, iv);
+    }
+
+    auto gost::decrypt_ofb(void const* const cipher, size_t const nbytes) const noexcept
+    -> std::vector<u8>
+    {
+        return stream::decrypt(*this, stream::ofb<gost>, cipher, nbytes);
+    }
+
+    auto gost::encrypt_cfb(void const* const data, size_t const nbytes, void const* const iv) const noexcept
+    -> std::vector<u8>
+    {
+        return stream::encrypt(*this, stream::cfb_encrypt<gost>, data, nbytes, iv);
+    }
+
+    auto gost::decrypt_cfb(void const* const cipher, size_t const nbytes) const noexcept
+    -> std::vector<u8>
+    {
+        return stream::decrypt(*this, stream::cfb_decrypt<gost>, cipher, nbytes);
+    }
+}
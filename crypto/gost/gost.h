@@ -4,27 +4,56 @@
 
 #pragma once
 #include "../../types.h"
+#include "../arena/arena.h"
 #include <cstddef>  // for size_t
+#include <vector>
 
 namespace bee::crypto {
     class gost final {
         static constexpr size_t BLOCK_SIZE = 8;
         static constexpr size_t KEY_SIZE = 32;
 
-        u32 k[8]{};
-        u8  k87[256]{};
-        u8  k65[256]{};
-        u8  k43[256]{};
-        u8  k21[256]{};
+        // Klucz i tablice podstawień trzymamy w zablokowanej pamięci (arena),
+        // która jest zerowana przy zwalnianiu obiektu.
+        struct tables {
+            u32 k[8];
+            u8  k87[256];
+            u8  k65[256];
+            u8  k43[256];
+            u8  k21[256];
+        };
+        secure_ptr<tables> ks_;
     public:
         gost(void const*, size_t);
-        ~gost();
+        /// Obiekt, z którego przeniesiono klucz, nie ma tablic - wolno go tylko
+        /// zniszczyć lub przypisać mu nowy obiekt (inne metody kończą się asercją).
+        gost(gost&&) noexcept = default;
+        gost& operator=(gost&&) noexcept = default;
 
         void encrypt_block(u32 const*, u32*) const noexcept;
         void decrypt_block(u32 const*, u32*) const noexcept;
 
+        /// Szyfrowanie w trybie OFB. Szyfrogram (bez 'uzupełnienia') poprzedzony jest wektorem IV.
+        /// \param iv Wektor IV (BLOCK_SIZE bajtów) lub nullptr, wtedy IV jest losowany.
+        auto encrypt_ofb(void const*, size_t, void const* = nullptr) const noexcept
+        -> std::vector<u8>;
+
+        auto decrypt_ofb(void const*, size_t) const noexcept
+        -> std::vector<u8>;
+
+        /// Szyfrowanie w trybie CFB (64-bitowym). Szyfrogram poprzedzony jest wektorem IV.
+        auto encrypt_cfb(void const*, size_t, void const* = nullptr) const noexcept
+        -> std::vector<u8>;
+
+        auto decrypt_cfb(void const*, size_t) const noexcept
+        -> std::vector<u8>;
+
+        static auto key_size() noexcept { return KEY_SIZE; }
+        static auto block_size() noexcept { return BLOCK_SIZE; }
+
     private:
         [[nodiscard]] u32 f(const u32 x) const noexcept {
+            auto const& [_, k87, k65, k43, k21] = *ks_;
             const auto w0 = static_cast<u32>(k87[(x >> 24) & 0xff]) << 24;
             const auto w1 = static_cast<u32>(k65[(x >> 16) & 0xff]) << 16;
             const auto w2 = static_cast<u32>(k43[(x >> 8) & 0xff]) <<  8;
@@ -0,0 +1,93 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#pragma once
+#include "../../types.h"
+#include <algorithm>
+#include <cstring>
+#include <span>
+
+namespace bee::crypto {
+    /// Fragmenty danych wejściowych (np. nagłówek, treść, stopka) i bufory wyjściowe.
+    using const_fragments = std::span<std::span<u8 const> const>;
+    using fragments = std::span<std::span<u8> const>;
+
+    template<typename Fragments>
+    size_t total_size(Fragments const parts) noexcept {
+        size_t n = 0;
+        for (auto const& part : parts)
+            n += part.size();
+        return n;
+    }
+
+    /// Kolejne bajty z ciągu fragmentów (blok może przekraczać granicę fragmentów).
+    class gather final {
+        const_fragments parts_;
+        size_t idx_{};
+        size_t pos_{};
+    public:
+        explicit gather(const_fragments const parts) noexcept : parts_{parts} {
+            advance(0);
+        }
+
+        /// Kopiuje do dst co najwyżej n kolejnych bajtów.
+        /// \return Liczba skopiowanych bajtów (mniejsza od n tylko na końcu danych).
+        size_t read(u8* dst, size_t const n) noexcept {
+            size_t done = 0;
+            while (done < n && idx_ < parts_.size()) {
+                auto const& part = parts_[idx_];
+                auto const k = std::min(n - done, part.size() - pos_);
+                std::memcpy(dst, part.data() + pos_, k);
+                dst += k;
+                done += k;
+                advance(k);
+            }
+            return done;
+        }
+
+    private:
+        void advance(size_t const k) noexcept {
+            pos_ += k;
+            while (idx_ < parts_.size() && pos_ == parts_[idx_].size()) {
+                ++idx_;
+                pos_ = 0;
+            }
+        }
+    };
+
+    /// Zapis kolejnych bajtów do ciągu fragmentów wyjściowych.
+    class scatter final {
+        fragments parts_;
+        size_t idx_{};
+        size_t pos_{};
+    public:
+        explicit scatter(fragments const parts) noexcept : parts_{parts} {
+            advance(0);
+        }
+
+        /// Zapisuje n bajtów.
+        /// \return FALSE, jeśli w fragmentach zabrakło miejsca.
+        bool write(u8 const* src, size_t const n) noexcept {
+            size_t done = 0;
+            while (done < n && idx_ < parts_.size()) {
+                auto const& part = parts_[idx_];
+                auto const k = std::min(n - done, part.size() - pos_);
+                std::memcpy(part.data() + pos_, src, k);
+                src += k;
+                done += k;
+                advance(k);
+            }
+            return done == n;
+        }
+
+    private:
+        void advance(size_t const k) noexcept {
+            pos_ += k;
+            while (idx_ < parts_.size() && pos_ == parts_[idx_].size()) {
+                ++idx_;
+                pos_ = 0;
+            }
+        }
+    };
+}
@@ -0,0 +1,190 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#include "kdf.h"
+#include "../crypto.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace bee::crypto {
+    namespace {
+        constexpr size_t BLOCK_SIZE = 64;
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                   h m a c _ s h a 2 5 6                       *
+    *                                                               *
+    ****************************************************************/
+
+    hmac_sha256::hmac_sha256(void const* const key, size_t const key_size) noexcept {
+        // Klucz dłuższy od bloku zastępujemy jego skrótem.
+        u8 block[BLOCK_SIZE]{};
+        if (key_size > BLOCK_SIZE)
+            sha256::digest(key, key_size, block);
+        else if (key_size)
+            std::memcpy(block, key, key_size);
+
+        u8 pad[BLOCK_SIZE];
+        for (size_t i = 0; i < BLOCK_SIZE; ++i)
+            pad[i] = block[i] ^ 0x36;
+        sha256::initial_state(inner_);
+        sha256::compress(inner_, pad);
+        for (size_t i = 0; i < BLOCK_SIZE; ++i)
+            pad[i] = block[i] ^ 0x5c;
+        sha256::initial_state(outer_);
+        sha256::compress(outer_, pad);
+
+        ctx_ = sha256{inner_, BLOCK_SIZE};
+        secure_zero(block, sizeof(block));
+        secure_zero(pad, sizeof(pad));
+    }
+
+    hmac_sha256::~hmac_sha256() {
+        secure_zero(inner_, sizeof(inner_));
+        secure_zero(outer_, sizeof(outer_));
+    }
+
+    void hmac_sha256::update(void const* const data, size_t const nbytes) noexcept {
+        ctx_.update(data, nbytes);
+    }
+
+    void hmac_sha256::final(u8* const tag) noexcept {
+        u8 digest[TAG_SIZE];
+        ctx_.final(digest);
+        sha256 outer{outer_, BLOCK_SIZE};
+        outer.update(digest, TAG_SIZE);
+        outer.final(tag);
+        ctx_ = sha256{inner_, BLOCK_SIZE};
+        secure_zero(digest, sizeof(digest));
+    }
+
+    void hmac_sha256::tag32(u8 const* const data, u8* const tag) const noexcept {
+        // Blok: 32 bajty danych, 0x80, zera i długość (64 + 32) * 8 bitów.
+        u8 block[BLOCK_SIZE]{};
+        block[TAG_SIZE] = 0x80;
+        store_be32(block + BLOCK_SIZE - 4, (BLOCK_SIZE + TAG_SIZE) * 8);
+
+        u32 state[8];
+        std::copy_n(inner_, 8, state);
+        std::memcpy(block, data, TAG_SIZE);
+        sha256::compress(state, block);
+
+        store_be32(block, state);
+        std::copy_n(outer_, 8, state);
+        sha256::compress(state, block);
+        store_be32(tag, state);
+
+        secure_zero(block, sizeof(block));
+        secure_zero(state, sizeof(state));
+    }
+}
+
+namespace bee::crypto::kdf {
+    /****************************************************************
+    *                                                               *
+    *                          p b k d f 2                          *
+    *                                                               *
+    ****************************************************************/
+
+    void pbkdf2_sha256(void const* const password, size_t const password_size,
+                       void const* const salt, size_t const salt_size,
+                       u32 const iterations, u8* out, size_t out_size) noexcept
+    {
+        constexpr auto H = hmac_sha256::TAG_SIZE;
+        hmac_sha256 prf{password, password_size};
+
+        u8 u[H], t[H], index[4];
+        for (u32 block = 1; out_size; ++block) {
+            store_be32(index, block);
+            prf.update(salt, salt_size);
+            prf.update(index, sizeof(index));
+            prf.final(u);
+            std::memcpy(t, u, H);
+
+            for (u32 i = 1; i < iterations; ++i) {
+                prf.tag32(u, u);
+                for (size_t k = 0; k < H; ++k)
+                    t[k] ^= u[k];
+            }
+
+            auto const n = std::min(out_size, H);
+            std::memcpy(out, t, n);
+            out += n;
+            out_size -= n;
+        }
+        secure_zero(u, sizeof(u));
+        secure_zero(t, sizeof(t));
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                          d e r i v e                          *
+    *                                                               *
+    ****************************************************************/
+
+    secure_bytes derive(void const* const password, size_t const password_size,
+                        void const* const salt, size_t const salt_size,
+                        params const& cost, size_t const size)
+    {
+        if (cost.iterations == 0 || cost.lanes == 0 || cost.lanes > MAX_LANES || size == 0 || (!password && password_size) || (!salt && salt_size))
+            return {};
+
+        constexpr auto H = hmac_sha256::TAG_SIZE;
+        secure_bytes lanes(cost.lanes * H);
+
+        auto const lane = [&](u32 const j) {
+            secure_bytes lane_salt(salt_size + sizeof(u32));
+            if (salt_size)
+                std::memcpy(lane_salt.data(), salt, salt_size);
+            store_be32(lane_salt.data() + salt_size, j);
+            pbkdf2_sha256(password, password_size, lane_salt.data(), lane_salt.size(), cost.iterations, lanes.data() + j * H, H);
+        };
+
+        // Wątki (bieżący i co najwyżej jeden mniej niż rdzeni) pobierają kolejne tory z licznika.
+        // Jeśli wątku nie da się utworzyć, jego tory policzą pozostałe.
+        std::atomic<u32> next{0};
+        auto const work = [&] {
+            for (u32 j; (j = next.fetch_add(1, std::memory_order_relaxed)) < cost.lanes;)
+                lane(j);
+        };
+        auto const threads = std::clamp<u32>(std::thread::hardware_concurrency(), 1, cost.lanes);
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (u32 i = 1; i < threads; ++i) {
+            try {
+                workers.emplace_back(work);
+            }
+            catch (std::system_error const&) {
+                break;
+            }
+        }
+        work();
+        for (auto& w : workers)
+            w.join();
+
+        secure_bytes key(size);
+        pbkdf2_sha256(password, password_size, lanes.data(), lanes.size(), 1, key.data(), key.size());
+        return key;
+    }
+
+    bool verify(void const* const password, size_t const password_size,
+                void const* const salt, size_t const salt_size,
+                params const& cost, void const* const expected, size_t const expected_size)
+    {
+        auto const key = derive(password, password_size, salt, salt_size, cost, expected_size);
+        if (key.size() != expected_size)
+            return false;
+
+        auto const ptr = static_cast<u8 const*>(expected);
+        u8 diff = 0;
+        for (size_t i = 0; i < expected_size; ++i)
+            diff |= key[i] ^ ptr[i];
+        return diff == 0;
+    }
+}
@@ -0,0 +1,85 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#pragma once
+#include "../../types.h"
+#include "../arena/arena.h"
+#include "sha256.h"
+
+namespace bee::crypto {
+    /// HMAC-SHA-256 (RFC 2104). Klucz jest przetwarzany raz (stany po blokach ipad/opad),
+    /// więc kolejne tagi z tym samym kluczem kosztują tylko przetworzenie danych.
+    class hmac_sha256 final {
+        u32 inner_[8];
+        u32 outer_[8];
+        sha256 ctx_;
+    public:
+        static constexpr size_t TAG_SIZE = sha256::DIGEST_SIZE;
+
+        hmac_sha256(void const* key, size_t key_size) noexcept;
+        ~hmac_sha256();
+        hmac_sha256(hmac_sha256 const&) = delete;
+        hmac_sha256& operator=(hmac_sha256 const&) = delete;
+
+        void update(void const* data, size_t nbytes) noexcept;
+        /// Zapis tagu (TAG_SIZE bajtów); obiekt jest gotowy do kolejnej wiadomości.
+        void final(u8* tag) noexcept;
+
+        /// Tag dla wiadomości dokładnie TAG_SIZE-bajtowej (kolejne iteracje PBKDF2):
+        /// dwa wywołania funkcji kompresji bez buforowania.
+        void tag32(u8 const* data, u8* tag) const noexcept;
+    };
+}
+
+// Wyprowadzanie kluczy z haseł.
+// Podstawą jest PBKDF2-HMAC-SHA-256 (RFC 8018). Koszt 'iterations' można podzielić
+// na 'lanes' niezależnych torów liczonych w osobnych wątkach:
+//   tor j  = PBKDF2(hasło, sól || be32(j), iterations, 32),
+//   klucz  = PBKDF2(hasło, tor 0 || tor 1 || ... , 1, size).
+// Praca atakującego rośnie z iterations * lanes, a czas wyprowadzenia na serwerze
+// z wieloma rdzeniami tylko z iterations. Zmiana lanes zmienia wynik - liczba torów
+// jest częścią parametrów zapisywanych razem z solą.
+namespace bee::crypto::kdf {
+    /// Największa dopuszczalna liczba torów - parametry z większą liczbą są odrzucane
+    /// (np. uszkodzone lub spreparowane parametry zapisane razem z solą).
+    constexpr u32 MAX_LANES = 256;
+
+    struct params {
+        u32 iterations{100'000};    // koszt jednego toru
+        u32 lanes{1};               // liczba torów (1..MAX_LANES)
+    };
+
+    /// Czysty PBKDF2-HMAC-SHA-256.
+    void pbkdf2_sha256(void const* password, size_t password_size,
+                       void const* salt, size_t salt_size,
+                       u32 iterations, u8* out, size_t out_size) noexcept;
+
+    /// Klucz o rozmiarze size wyprowadzony z hasła i soli.
+    /// Tory liczone są przez co najwyżej tyle wątków, ile rdzeni ma procesor.
+    /// \return Klucz w zablokowanej pamięci lub pusty bufor, jeśli parametry są niepoprawne.
+    secure_bytes derive(void const* password, size_t password_size,
+                        void const* salt, size_t salt_size,
+                        params const& cost, size_t size);
+
+    secure_bytes derive(BytesView auto const password, BytesView auto const salt, params const& cost, size_t const size) {
+        return derive(password.data(), password.size(), salt.data(), salt.size(), cost, size);
+    }
+
+    /// Sprawdzenie hasła (porównanie w czasie niezależnym od miejsca różnicy).
+    bool verify(void const* password, size_t password_size,
+                void const* salt, size_t salt_size,
+                params const& cost, void const* expected, size_t expected_size);
+
+    /// Szyfr z kluczem wyprowadzonym z hasła (maksymalna długość klucza szyfru).
+    template<typename Cipher>
+    Cipher make_cipher(BytesView auto const password, BytesView auto const salt, params const& cost) {
+        size_t size;
+        if constexpr (requires { Cipher::key_size(); })
+            size = Cipher::key_size();
+        else
+            size = Cipher::key_max_size();
+        auto const key = derive(password, salt, cost, size);
+        return Cipher{key.data(), key.size()};
+    }
+}
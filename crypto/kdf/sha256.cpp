@@ -0,0 +1,138 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#include "sha256.h"
+#include "../crypto.h"
+#include <algorithm>
+#include <cstring>
+
+namespace bee::crypto {
+    namespace {
+        constexpr u32 K[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+
+        constexpr u32 rotr(u32 const v, int const n) noexcept {
+            return (v >> n) | (v << (32 - n));
+        }
+    }
+
+    sha256::~sha256() {
+        secure_zero(state_, sizeof(state_));
+        secure_zero(pending_, sizeof(pending_));
+    }
+
+    void sha256::initial_state(u32 (&state)[8]) noexcept {
+        static constexpr u32 H0[8] = {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+        };
+        std::copy_n(H0, 8, state);
+    }
+
+    sha256::sha256(u32 const (&state)[8], u64 const processed) noexcept : total_{processed} {
+        std::copy_n(state, 8, state_);
+    }
+
+    void sha256::reset() noexcept {
+        initial_state(state_);
+        pending_size_ = 0;
+        total_ = 0;
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                      c o m p r e s s                          *
+    *                                                               *
+    ****************************************************************/
+
+    void sha256::compress(u32 (&state)[8], u8 const* const block) noexcept {
+        u32 w[64];
+        for (int i = 0; i < 16; ++i)
+            w[i] = load_be32(block + 4 * i);
+        for (int i = 16; i < 64; ++i) {
+            auto const s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            auto const s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        auto [a, b, c, d, e, f, g, h] = state;
+        for (int i = 0; i < 64; ++i) {
+            auto const t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+            auto const t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                   u p d a t e  /  f i n a l                   *
+    *                                                               *
+    ****************************************************************/
+
+    void sha256::update(void const* const data, size_t nbytes) noexcept {
+        auto ptr = static_cast<u8 const*>(data);
+        total_ += nbytes;
+
+        if (pending_size_) {
+            auto const n = std::min(nbytes, BLOCK_SIZE - pending_size_);
+            std::memcpy(pending_ + pending_size_, ptr, n);
+            pending_size_ += n;
+            ptr += n;
+            nbytes -= n;
+            if (pending_size_ < BLOCK_SIZE)
+                return;
+            compress(state_, pending_);
+            pending_size_ = 0;
+        }
+        // Pełne bloki bezpośrednio z danych wejściowych.
+        for (; nbytes >= BLOCK_SIZE; ptr += BLOCK_SIZE, nbytes -= BLOCK_SIZE)
+            compress(state_, ptr);
+        std::memcpy(pending_, ptr, nbytes);
+        pending_size_ = nbytes;
+    }
+
+    void sha256::final(u8* const digest) noexcept {
+        auto const bits = total_ * 8;
+        pending_[pending_size_++] = 0x80;
+        if (pending_size_ > BLOCK_SIZE - sizeof(u64)) {
+            std::memset(pending_ + pending_size_, 0, BLOCK_SIZE - pending_size_);
+            compress(state_, pending_);
+            pending_size_ = 0;
+        }
+        std::memset(pending_ + pending_size_, 0, BLOCK_SIZE - sizeof(u64) - pending_size_);
+        store_be32(pending_ + BLOCK_SIZE - 8, static_cast<u32>(bits >> 32));
+        store_be32(pending_ + BLOCK_SIZE - 4, static_cast<u32>(bits));
+        compress(state_, pending_);
+        store_be32(digest, state_);
+        reset();
+    }
+
+    void sha256::digest(void const* const data, size_t const nbytes, u8* const digest) noexcept {
+        sha256 ctx;
+        ctx.update(data, nbytes);
+        ctx.final(digest);
+    }
+}
@@ -0,0 +1,40 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#pragma once
+#include "../../types.h"
+
+namespace bee::crypto {
+    /// SHA-256 (FIPS 180-4). Dane można podawać w kolejnych porcjach (update).
+    class sha256 final {
+        static constexpr size_t BLOCK_SIZE = 64;
+
+        u32 state_[8];
+        u8 pending_[BLOCK_SIZE]{};
+        size_t pending_size_{};
+        u64 total_{};
+    public:
+        static constexpr size_t DIGEST_SIZE = 32;
+
+        sha256() noexcept { reset(); }
+        /// Kontynuacja od stanu po przetworzeniu 'processed' bajtów (wielokrotność bloku).
+        sha256(u32 const (&state)[8], u64 processed) noexcept;
+        sha256(sha256 const&) = default;
+        sha256& operator=(sha256 const&) = default;
+        ~sha256();
+
+        void reset() noexcept;
+        void update(void const* data, size_t nbytes) noexcept;
+        /// Zapis skrótu (DIGEST_SIZE bajtów); obiekt wraca do stanu początkowego.
+        void final(u8* digest) noexcept;
+
+        /// Skrót całych danych w jednym wywołaniu.
+        static void digest(void const* data, size_t nbytes, u8* digest) noexcept;
+
+        /// Przetworzenie jednego bloku (64 bajty) bez buforowania - dla HMAC/PBKDF2,
+        /// które same przygotowują bloki o stałym układzie.
+        static void compress(u32 (&state)[8], u8 const* block) noexcept;
+        static void initial_state(u32 (&state)[8]) noexcept;
+    };
+}
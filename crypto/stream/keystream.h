@@ -0,0 +1,137 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#pragma once
+#include "../../types.h"
+#include "../crypto.h"
+#include "../arena/arena.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+namespace bee::crypto {
+    /// Generator strumienia klucza OFB liczonego z wyprzedzeniem w wątku tła.
+    /// Strumień trafia do bufora cyklicznego (w pamięci z arena), więc szyfrowanie
+    /// wiadomości sprowadza się do operacji XOR na gotowych bajtach.
+    /// Kolejne wywołania apply() zużywają kolejne bajty jednego strumienia OFB
+    /// (ten sam wynik co encrypt_ofb dla połączonych wiadomości i tego samego IV).
+    /// apply() może być wywoływane tylko z jednego wątku naraz.
+    template<typename Cipher>
+    class keystream final {
+        static constexpr size_t BLOCK_SIZE = 8;
+        static constexpr size_t CHUNK_SIZE = 4096;
+
+        Cipher const& cipher_;
+        size_t const capacity_;
+        secure_bytes ring_;
+        u32 state_[2]{};
+
+        // Liczniki wszystkich wyprodukowanych i zużytych bajtów.
+        std::atomic<size_t> head_{0};
+        std::atomic<size_t> tail_{0};
+        std::atomic<bool> producer_waiting_{false};
+        std::atomic<bool> consumer_waiting_{false};
+        std::atomic<bool> stop_{false};
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::thread worker_;
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+        /// \param cipher Szyfr (musi istnieć dłużej niż generator),
+        /// \param iv Wektor inicjujący (BLOCK_SIZE bajtów),
+        /// \param capacity Rozmiar bufora (zaokrąglany w górę do wielokrotności 4 KiB).
+        keystream(Cipher const& cipher, void const* const iv, size_t const capacity = DEFAULT_CAPACITY)
+            : cipher_{cipher},
+              capacity_{std::max(CHUNK_SIZE, (capacity + CHUNK_SIZE - 1) / CHUNK_SIZE * CHUNK_SIZE)},
+              ring_(capacity_)
+        {
+            load_le32(iv, state_);
+            worker_ = std::thread{[this] { produce(); }};
+        }
+
+        keystream(keystream const&) = delete;
+        keystream& operator=(keystream const&) = delete;
+
+        ~keystream() {
+            {
+                std::lock_guard lock{mutex_};
+                stop_ = true;
+            }
+            cv_.notify_all();
+            worker_.join();
+            secure_zero(state_, sizeof(state_));
+        }
+
+        /// XOR nbytes bajtów z src z kolejnymi bajtami strumienia (wynik w dst).
+        /// Czeka, jeśli wątek tła nie nadąża z generowaniem.
+        void apply(void const* const src, void* const dst, size_t nbytes) noexcept {
+            auto in = static_cast<u8 const*>(src);
+            auto out = static_cast<u8*>(dst);
+
+            while (nbytes) {
+                auto const tail = tail_.load(std::memory_order_relaxed);
+                auto const available = head_.load(std::memory_order_acquire) - tail;
+                if (available == 0) {
+                    std::unique_lock lock{mutex_};
+                    consumer_waiting_ = true;
+                    cv_.wait(lock, [&] { return head_.load() != tail; });
+                    consumer_waiting_ = false;
+                    continue;
+                }
+
+                auto const pos = tail % capacity_;
+                auto const n = std::min({available, nbytes, capacity_ - pos});
+                auto const ks = ring_.data() + pos;
+                for (size_t i = 0; i < n; ++i)
+                    out[i] = in[i] ^ ks[i];
+                secure_zero(ks, n);     // zużyty strumień nie zostaje w pamięci
+
+                tail_.store(tail + n);
+                if (producer_waiting_.load()) {
+                    std::lock_guard lock{mutex_};
+                    cv_.notify_all();
+                }
+                in += n;
+                out += n;
+                nbytes -= n;
+            }
+        }
+
+    private:
+        void produce() noexcept {
+            for (;;) {
+                auto const head = head_.load(std::memory_order_relaxed);
+                if (capacity_ - (head - tail_.load()) < CHUNK_SIZE) {
+                    std::unique_lock lock{mutex_};
+                    producer_waiting_ = true;
+                    cv_.wait(lock, [&] { return stop_ || capacity_ - (head_.load() - tail_.load()) >= CHUNK_SIZE; });
+                    producer_waiting_ = false;
+                    if (stop_)
+                        return;
+                    continue;
+                }
+
+                // capacity_ jest wielokrotnością CHUNK_SIZE, więc porcja nie zawija się w buforze.
+                auto dst = ring_.data() + head % capacity_;
+                for (size_t i = 0; i < CHUNK_SIZE / BLOCK_SIZE; ++i) {
+                    cipher_.encrypt_block(state_, state_);
+                    store_le32(dst, state_);
+                    dst += BLOCK_SIZE;
+                }
+                head_.store(head + CHUNK_SIZE);
+
+                if (consumer_waiting_.load()) {
+                    std::lock_guard lock{mutex_};
+                    cv_.notify_all();
+                }
+                if (stop_.load(std::memory_order_relaxed))
+                    return;
+            }
+        }
+    };
+}
@@ -0,0 +1,116 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#pragma once
+#include "../../types.h"
+#include "../../csprng.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// Tryby strumieniowe (OFB, CFB) dla szyfrów o 64-bitowym bloku.
+// Tryby nie wymagają 'uzupełnienia' - szyfrogram ma długość jawnego tekstu,
+// a ostatni niepełny blok jest XOR-owany z początkiem bloku strumienia klucza.
+// 'state' to bieżący rejestr przesuwny (na początku IV), aktualizowany po każdym bloku,
+// dzięki czemu dane można przetwarzać w kolejnych porcjach.
+namespace bee::crypto::stream {
+    constexpr size_t BLOCK_SIZE = 8;
+
+    inline void xor_block(u8* const dst, u8 const* const src, u32 const (&ks)[2], size_t const n) noexcept {
+        u8 bytes[BLOCK_SIZE];
+        store_le32(bytes, ks);
+        for (size_t i = 0; i < n; ++i)
+            dst[i] = src[i] ^ bytes[i];
+    }
+
+    /// Zastąpienie pierwszych n bajtów rejestru (w kolejności little-endian) bajtami z src.
+    inline void set_prefix(u32 (&state)[2], u8 const* const src, size_t const n) noexcept {
+        u8 bytes[BLOCK_SIZE];
+        store_le32(bytes, state);
+        std::memcpy(bytes, src, n);
+        load_le32(bytes, state);
+    }
+
+    /// OFB: strumień klucza to kolejne szyfrowania rejestru; szyfrowanie i odszyfrowanie są identyczne.
+    template<typename Cipher>
+    void ofb(Cipher const& cipher, u32 (&state)[2], u8 const* src, u8* dst, size_t nbytes) noexcept {
+        while (nbytes) {
+            cipher.encrypt_block(state, state);
+            auto const n = std::min(nbytes, BLOCK_SIZE);
+            xor_block(dst, src, state, n);
+            src += n;
+            dst += n;
+            nbytes -= n;
+        }
+    }
+
+    /// CFB (64-bitowy): rejestr to poprzedni blok szyfrogramu.
+    template<typename Cipher>
+    void cfb_encrypt(Cipher const& cipher, u32 (&state)[2], u8 const* src, u8* dst, size_t nbytes) noexcept {
+        while (nbytes) {
+            cipher.encrypt_block(state, state);
+            auto const n = std::min(nbytes, BLOCK_SIZE);
+            xor_block(dst, src, state, n);
+            set_prefix(state, dst, n);
+            src += n;
+            dst += n;
+            nbytes -= n;
+        }
+    }
+
+    template<typename Cipher>
+    void cfb_decrypt(Cipher const& cipher, u32 (&state)[2], u8 const* src, u8* dst, size_t nbytes) noexcept {
+        while (nbytes) {
+            cipher.encrypt_block(state, state);
+            auto const n = std::min(nbytes, BLOCK_SIZE);
+            u8 next[BLOCK_SIZE];
+            std::memcpy(next, src, n);      // src i dst mogą być tym samym buforem
+            xor_block(dst, src, state, n);
+            set_prefix(state, next, n);
+            src += n;
+            dst += n;
+            nbytes -= n;
+        }
+    }
+
+    template<typename Cipher>
+    using mode = void (*)(Cipher const&, u32 (&)[2], u8 const*, u8*, size_t) noexcept;
+
+    /// Szyfrowanie w trybie strumieniowym z IV jako pierwszym blokiem wyniku.
+    /// \param iv Wektor IV (BLOCK_SIZE bajtów) lub nullptr, wtedy IV jest losowany.
+    template<typename Cipher>
+    auto encrypt(Cipher const& cipher, mode<Cipher> const fn, void const* const data, size_t const nbytes, void const* const iv) noexcept
+    -> std::vector<u8>
+    {
+        if (!data || nbytes == 0)
+            return {};
+
+        std::vector<u8> cipher_text(BLOCK_SIZE + nbytes);
+        if (iv)
+            std::memcpy(cipher_text.data(), iv, BLOCK_SIZE);
+        else
+            csprng::instance().fill(cipher_text.data(), BLOCK_SIZE);
+
+        u32 state[2];
+        load_le32(cipher_text.data(), state);
+        fn(cipher, state, static_cast<u8 const*>(data), cipher_text.data() + BLOCK_SIZE, nbytes);
+        return cipher_text;
+    }
+
+    /// Odszyfrowanie danych utworzonych przez encrypt (IV + szyfrogram).
+    template<typename Cipher>
+    auto decrypt(Cipher const& cipher, mode<Cipher> const fn, void const* const data, size_t const nbytes) noexcept
+    -> std::vector<u8>
+    {
+        if (!data || nbytes <= BLOCK_SIZE)
+            return {};
+
+        auto const ptr = static_cast<u8 const*>(data);
+        std::vector<u8> plain(nbytes - BLOCK_SIZE);
+        u32 state[2];
+        load_le32(ptr, state);
+        fn(cipher, state, ptr + BLOCK_SIZE, plain.data(), plain.size());
+        return plain;
+    }
+}
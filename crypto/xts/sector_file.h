@@ -0,0 +1,177 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#pragma once
+#include "xts.h"
+#include "../arena/arena.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bee::crypto {
+    /// Zaszyfrowany plik z dostępem swobodnym, zapisywany sektorami w trybie xts.
+    /// Odczyt i zapis dowolnego fragmentu dotyczy tylko sektorów, które się z nim pokrywają.
+    /// Plik ma zawsze rozmiar będący wielokrotnością sektora; końcówka ostatniego sektora
+    /// (i ewentualne luki przy zapisie za końcem pliku) zawiera zaszyfrowane zera.
+    /// Plik trzyma kopię trybu xts, a więc referencje do jego szyfrów - szyfry muszą istnieć dłużej niż plik.
+    template<typename Cipher>
+    class sector_file final {
+        int fd_{-1};
+        xts<Cipher> xts_;
+        size_t sector_size_;
+        secure_bytes buffer_;
+
+        sector_file(int const fd, xts<Cipher> const& mode, size_t const sector_size)
+            : fd_{fd}, xts_{mode}, sector_size_{sector_size}, buffer_(sector_size) {}
+    public:
+        static constexpr size_t DEFAULT_SECTOR_SIZE = 4096;
+
+        sector_file(sector_file&& other) noexcept
+            : fd_{std::exchange(other.fd_, -1)}, xts_{other.xts_},
+              sector_size_{other.sector_size_}, buffer_{std::move(other.buffer_)} {}
+        sector_file(sector_file const&) = delete;
+        sector_file& operator=(sector_file const&) = delete;
+        sector_file& operator=(sector_file&&) = delete;
+
+        ~sector_file() {
+            if (fd_ != -1)
+                close(fd_);
+        }
+
+        /// Otwarcie (lub utworzenie) zaszyfrowanego pliku.
+        /// \param fpath Ścieżka do pliku,
+        /// \param mode Tryb xts z szyframi dla danych i tweak'a (szyfry muszą istnieć dłużej niż plik),
+        /// \param writable Czy plik ma być otwarty do zapisu (tworzony, jeśli nie istnieje),
+        /// \param sector_size Rozmiar sektora (wielokrotność bloku szyfru).
+        /// \return Obiekt pliku lub nic w przypadku błędu.
+        static auto open(
+            std::string const& fpath,
+            xts<Cipher> const& mode,
+            bool const writable = false,
+            size_t const sector_size = DEFAULT_SECTOR_SIZE) noexcept
+        -> std::optional<sector_file>
+        {
+            if (sector_size == 0 || sector_size % xts<Cipher>::block_size()) {
+                std::cerr << "Error (sector_file): invalid sector size\n";
+                return {};
+            }
+            auto const flags = writable ? (O_RDWR | O_CREAT) : O_RDONLY;
+            auto const fd = ::open(fpath.c_str(), flags, 0600);
+            if (fd == -1) {
+                std::cerr << strerror(errno) << std::endl;
+                return {};
+            }
+            return sector_file{fd, mode, sector_size};
+        }
+
+        /// Rozmiar pliku (zawsze wielokrotność sektora).
+        [[nodiscard]] auto size() const noexcept -> u64 {
+            struct stat st{};
+            if (fstat(fd_, &st) == -1)
+                return 0;
+            return static_cast<u64>(st.st_size) / sector_size_ * sector_size_;
+        }
+
+        [[nodiscard]] auto sector_size() const noexcept { return sector_size_; }
+
+        /// Odczyt nbytes odszyfrowanych bajtów od pozycji offset.
+        /// \return Liczba odczytanych bajtów (mniejsza przy końcu pliku) lub nic w przypadku błędu.
+        auto read(u64 offset, void* const data, size_t nbytes) noexcept
+        -> std::optional<size_t>
+        {
+            auto const end = size();
+            if (offset >= end)
+                return 0;
+            nbytes = static_cast<size_t>(std::min<u64>(nbytes, end - offset));
+
+            auto dst = static_cast<u8*>(data);
+            size_t done = 0;
+            while (done < nbytes) {
+                auto const sector = offset / sector_size_;
+                auto const pos = static_cast<size_t>(offset % sector_size_);
+                auto const n = std::min(sector_size_ - pos, nbytes - done);
+
+                if (pos == 0 && n == sector_size_) {
+                    // Cały sektor - odszyfrowanie wprost do bufora wywołującego.
+                    if (!read_sector(sector, dst))
+                        return {};
+                } else {
+                    if (!read_sector(sector, buffer_.data()))
+                        return {};
+                    std::memcpy(dst, buffer_.data() + pos, n);
+                }
+                offset += n;
+                dst += n;
+                done += n;
+            }
+            return done;
+        }
+
+        /// Zapis nbytes bajtów od pozycji offset.
+        /// Częściowo nadpisywane sektory są odczytywane, modyfikowane i szyfrowane ponownie.
+        bool write(u64 offset, void const* const data, size_t const nbytes) noexcept {
+            auto const count = size() / sector_size_;
+            auto const first = offset / sector_size_;
+
+            // Luka za końcem pliku wypełniana jest zaszyfrowanymi zerami.
+            for (auto sector = count; sector < first; ++sector) {
+                std::memset(buffer_.data(), 0, sector_size_);
+                if (!write_sector(sector, buffer_.data()))
+                    return false;
+            }
+
+            auto src = static_cast<u8 const*>(data);
+            size_t done = 0;
+            while (done < nbytes) {
+                auto const sector = offset / sector_size_;
+                auto const pos = static_cast<size_t>(offset % sector_size_);
+                auto const n = std::min(sector_size_ - pos, nbytes - done);
+
+                if (n != sector_size_) {
+                    if (sector < count) {
+                        if (!read_sector(sector, buffer_.data()))
+                            return false;
+                    } else
+                        std::memset(buffer_.data(), 0, sector_size_);
+                }
+                std::memcpy(buffer_.data() + pos, src, n);
+                if (!write_sector(sector, buffer_.data()))
+                    return false;
+
+                offset += n;
+                src += n;
+                done += n;
+            }
+            return true;
+        }
+
+    private:
+        bool read_sector(u64 const sector, u8* const dst) const noexcept {
+            auto const n = pread(fd_, dst, sector_size_, static_cast<off_t>(sector * sector_size_));
+            if (n != static_cast<ssize_t>(sector_size_)) {
+                std::cerr << "Error (sector_file): " << (n == -1 ? strerror(errno) : "short read") << '\n';
+                return false;
+            }
+            return xts_.decrypt_sector(sector, dst, dst, sector_size_);
+        }
+
+        // Szyfruje zawartość src w miejscu i zapisuje sektor.
+        bool write_sector(u64 const sector, u8* const src) noexcept {
+            xts_.encrypt_sector(sector, src, src, sector_size_);
+            auto const n = pwrite(fd_, src, sector_size_, static_cast<off_t>(sector * sector_size_));
+            if (n != static_cast<ssize_t>(sector_size_)) {
+                std::cerr << "Error (sector_file): " << (n == -1 ? strerror(errno) : "short write") << '\n';
+                return false;
+            }
+            return true;
+        }
+    };
+}
@@ -0,0 +1,83 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#pragma once
+#include "../../types.h"
+#include <cstring>
+
+namespace bee::crypto {
+    /// Tryb sektorowy w stylu XTS dla szyfrów o 64-bitowym bloku (blowfish, gost).
+    /// Każdy sektor szyfrowany jest niezależnie, z tweak'iem wyznaczonym z numeru sektora:
+    ///     T = E_tweak(sektor), C_j = E_data(P_j ^ T_j) ^ T_j, T_{j+1} = T_j * x w GF(2^64).
+    /// Dzięki temu odczyt i zapis dowolnego sektora kosztuje pracę szyfru dla jednego sektora.
+    /// Rozmiar sektora musi być wielokrotnością bloku (brak 'ciphertext stealing').
+    /// Szyfry do danych i do tweak'a powinny mieć różne klucze.
+    template<typename Cipher>
+    class xts final {
+        static constexpr size_t BLOCK_SIZE = 8;
+        // x^64 + x^4 + x^3 + x + 1
+        static constexpr u64 POLYNOMIAL = 0x1b;
+
+        Cipher const& data_;
+        Cipher const& tweak_;
+    public:
+        /// \param data_cipher Szyfr dla danych (musi istnieć dłużej niż obiekt xts i jego kopie),
+        /// \param tweak_cipher Szyfr dla tweak'a (musi istnieć dłużej niż obiekt xts i jego kopie).
+        xts(Cipher const& data_cipher, Cipher const& tweak_cipher) noexcept
+            : data_{data_cipher}, tweak_{tweak_cipher} {}
+
+        // Obiekty tymczasowe zniknęłyby przed pierwszym użyciem trybu.
+        xts(Cipher&&, Cipher const&) = delete;
+        xts(Cipher const&, Cipher&&) = delete;
+        xts(Cipher&&, Cipher&&) = delete;
+
+        /// Szyfrowanie jednego sektora (src i dst mogą wskazywać ten sam bufor).
+        /// \return FALSE, jeśli nbytes nie jest wielokrotnością bloku.
+        bool encrypt_sector(u64 const sector, void const* const src, void* const dst, size_t const nbytes) const noexcept {
+            return process(sector, src, dst, nbytes, true);
+        }
+
+        /// Odszyfrowanie jednego sektora (src i dst mogą wskazywać ten sam bufor).
+        /// \return FALSE, jeśli nbytes nie jest wielokrotnością bloku.
+        bool decrypt_sector(u64 const sector, void const* const src, void* const dst, size_t const nbytes) const noexcept {
+            return process(sector, src, dst, nbytes, false);
+        }
+
+        static auto block_size() noexcept { return BLOCK_SIZE; }
+
+    private:
+        bool process(u64 const sector, void const* const src, void* const dst, size_t const nbytes, bool const encrypt) const noexcept {
+            if (nbytes % BLOCK_SIZE)
+                return false;
+
+            u32 const number[2]{static_cast<u32>(sector), static_cast<u32>(sector >> 32)};
+            u32 tw[2];
+            tweak_.encrypt_block(number, tw);
+            u64 t = static_cast<u64>(tw[0]) | static_cast<u64>(tw[1]) << 32;
+
+            auto in = static_cast<u8 const*>(src);
+            auto out = static_cast<u8*>(dst);
+            for (size_t i = 0; i < nbytes / BLOCK_SIZE; ++i) {
+                u32 const mask[2]{static_cast<u32>(t), static_cast<u32>(t >> 32)};
+                u32 block[2];
+                load_le32(in, block);
+                block[0] ^= mask[0];
+                block[1] ^= mask[1];
+                if (encrypt)
+                    data_.encrypt_block(block, block);
+                else
+                    data_.decrypt_block(block, block);
+                block[0] ^= mask[0];
+                block[1] ^= mask[1];
+                store_le32(out, block);
+
+                // Następny tweak: mnożenie przez x w GF(2^64).
+                t = (t << 1) ^ ((t >> 63) * POLYNOMIAL);
+                in += BLOCK_SIZE;
+                out += BLOCK_SIZE;
+            }
+            return true;
+        }
+    };
+}
@@ -0,0 +1,293 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Created by piotr on 18.10.26.
+#pragma once
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "types.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <random>
+#include <pthread.h>
+#if __has_include(<sys/random.h>)
+#include <sys/random.h>
+#endif
+
+namespace bee {
+    /// Kryptograficznie bezpieczny generator liczb losowych (ChaCha20).
+    /// Każdy wątek ma własną instancję (bez blokad), inicjowaną jednorazowo z getrandom.
+    /// Strumień generowany jest całymi blokami do bufora; po każdym uzupełnieniu bufora
+    /// pierwsze 32 bajty stają się nowym kluczem (fast key erasure), więc przejęcie stanu
+    /// nie ujawnia wcześniej wygenerowanych bajtów.
+    /// Generator jest ponownie inicjowany z systemu co RESEED_INTERVAL bajtów i po fork().
+    class csprng final {
+        static constexpr size_t BLOCK_SIZE = 64;
+        static constexpr size_t BUFFER_BLOCKS = 8;
+        static constexpr size_t BUFFER_SIZE = BLOCK_SIZE * BUFFER_BLOCKS;
+        static constexpr size_t KEY_SIZE = 32;
+        static constexpr u64 RESEED_INTERVAL = u64{1} << 20;
+
+        u32 key_[KEY_SIZE / sizeof(u32)]{};
+        u8 buffer_[BUFFER_SIZE]{};
+        size_t available_{};
+        u64 generated_{RESEED_INTERVAL};
+        u64 fork_generation_{};
+
+        csprng() = default;
+    public:
+        csprng(csprng const&) = delete;
+        csprng& operator=(csprng const&) = delete;
+
+        ~csprng() {
+            std::memset(key_, 0, sizeof(key_));
+            std::memset(buffer_, 0, sizeof(buffer_));
+            __asm__ __volatile__("" : : "r"(key_), "r"(buffer_) : "memory");
+        }
+
+        /// Generator bieżącego wątku.
+        static csprng& instance() noexcept {
+            thread_local csprng rng;
+            return rng;
+        }
+
+        /// Wypełnienie bufora losowymi bajtami.
+        /// Małe żądania obsługiwane są z bufora, duże generowane są
+        /// bezpośrednio do pamięci wywołującego (bez kopiowania przez bufor).
+        void fill(void* const data, size_t nbytes) noexcept {
+            auto dst = static_cast<u8*>(data);
+            if (fork_generation_ != fork_generation().load(std::memory_order_relaxed))
+                available_ = 0;
+
+            // Najpierw wydajemy to, co zostało w buforze.
+            auto n = std::min(nbytes, available_);
+            take(dst, n);
+            dst += n;
+            nbytes -= n;
+
+            if (nbytes >= BUFFER_SIZE) {
+                n = nbytes - nbytes % BLOCK_SIZE;
+                generate(dst, n);
+                dst += n;
+                nbytes -= n;
+            }
+
+            while (nbytes) {
+                if (available_ == 0)
+                    refill();
+                n = std::min(nbytes, available_);
+                take(dst, n);
+                dst += n;
+                nbytes -= n;
+            }
+        }
+
+        /// Blok strumienia ChaCha20 (20 rund, 64-bitowy licznik, zerowy nonce).
+        static void chacha20_block(u32 const (&key)[8], u64 const counter, u8* const out) noexcept {
+            u32 const input[16] = {
+                0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+                key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+                static_cast<u32>(counter), static_cast<u32>(counter >> 32), 0, 0
+            };
+            u32 x[16];
+            std::memcpy(x, input, sizeof(x));
+
+            for (int i = 0; i < 10; ++i) {
+                // kolumny
+                quarter_round(x[0], x[4], x[8], x[12]);
+                quarter_round(x[1], x[5], x[9], x[13]);
+                quarter_round(x[2], x[6], x[10], x[14]);
+                quarter_round(x[3], x[7], x[11], x[15]);
+                // przekątne
+                quarter_round(x[0], x[5], x[10], x[15]);
+                quarter_round(x[1], x[6], x[11], x[12]);
+                quarter_round(x[2], x[7], x[8], x[13]);
+                quarter_round(x[3], x[4], x[9], x[14]);
+            }
+
+            for (int i = 0; i < 16; ++i)
+                x[i] += input[i];
+
+            store_le32(out, x);
+        }
+
+        /// Cztery kolejne bloki strumienia (liczniki counter..counter+3) liczone równolegle
+        /// w rejestrach wektorowych - szybsza ścieżka dla dużych żądań.
+        static void chacha20_block4(u32 const (&key)[8], u64 const counter, u8* const out) noexcept {
+            using v4 = u32 __attribute__((vector_size(16)));
+            v4 input[16];
+            u32 const constants[4] = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574};
+            for (int i = 0; i < 4; ++i)
+                input[i] = v4{} + constants[i];
+            for (int i = 0; i < 8; ++i)
+                input[4 + i] = v4{} + key[i];
+            for (u32 i = 0; i < 4; ++i) {
+                input[12][i] = static_cast<u32>(counter + i);
+                input[13][i] = static_cast<u32>((counter + i) >> 32);
+            }
+            input[14] = input[15] = v4{};
+
+            v4 x[16];
+            for (int i = 0; i < 16; ++i)
+                x[i] = input[i];
+
+            auto const qr = [](v4& a, v4& b, v4& c, v4& d) {
+                a += b; d ^= a; d = (d << 16) | (d >> 16);
+                c += d; b ^= c; b = (b << 12) | (b >> 20);
+                a += b; d ^= a; d = (d << 8) | (d >> 24);
+                c += d; b ^= c; b = (b << 7) | (b >> 25);
+            };
+            for (int i = 0; i < 10; ++i) {
+                qr(x[0], x[4], x[8], x[12]);
+                qr(x[1], x[5], x[9], x[13]);
+                qr(x[2], x[6], x[10], x[14]);
+                qr(x[3], x[7], x[11], x[15]);
+                qr(x[0], x[5], x[10], x[15]);
+                qr(x[1], x[6], x[11], x[12]);
+                qr(x[2], x[7], x[8], x[13]);
+                qr(x[3], x[4], x[9], x[14]);
+            }
+
+            // Transpozycja: słowo i bloku j leży w x[i][j].
+            for (int j = 0; j < 4; ++j) {
+                for (int i = 0; i < 16; ++i) {
+                    store_le32(out + j * BLOCK_SIZE + 4 * i, x[i][j] + input[i][j]);
+                }
+            }
+        }
+
+    private:
+        static u32 rotl(u32 const v, int const n) noexcept {
+            return (v << n) | (v >> (32 - n));
+        }
+
+        static void quarter_round(u32& a, u32& b, u32& c, u32& d) noexcept {
+            a += b; d ^= a; d = rotl(d, 16);
+            c += d; b ^= c; b = rotl(b, 12);
+            a += b; d ^= a; d = rotl(d, 8);
+            c += d; b ^= c; b = rotl(b, 7);
+        }
+
+        // Licznik zwiększany w procesie potomnym po fork(), aby potomek
+        // nie powtarzał strumienia rodzica.
+        static std::atomic<u64>& fork_generation() noexcept {
+            static std::atomic<u64> generation{0};
+            static bool const registered = [] {
+                pthread_atfork(nullptr, nullptr, [] {
+                    generation.fetch_add(1, std::memory_order_relaxed);
+                });
+                return true;
+            }();
+            (void)registered;
+            return generation;
+        }
+
+        // Pobranie nowego klucza z systemu.
+        void reseed() noexcept {
+            u8 seed[KEY_SIZE];
+            size_t got = 0;
+#if __has_include(<sys/random.h>)
+            while (got < KEY_SIZE) {
+                auto const n = getrandom(seed + got, KEY_SIZE - got, 0);
+                if (n <= 0)
+                    break;
+                got += static_cast<size_t>(n);
+            }
+#endif
+            if (got < KEY_SIZE) {
+                std::random_device rd;
+                for (size_t i = 0; i < KEY_SIZE; i += sizeof(u32)) {
+                    auto const v = static_cast<u32>(rd());
+                    std::memcpy(seed + i, &v, sizeof(v));
+                }
+            }
+            // Nowe ziarno mieszamy z dotychczasowym kluczem.
+            for (size_t i = 0; i < KEY_SIZE / sizeof(u32); ++i) {
+                key_[i] ^= load_le32(seed + i * sizeof(u32));
+            }
+            std::memset(seed, 0, sizeof(seed));
+            generated_ = 0;
+            fork_generation_ = fork_generation().load(std::memory_order_relaxed);
+        }
+
+        void reseed_if_needed() noexcept {
+            if (generated_ >= RESEED_INTERVAL || fork_generation_ != fork_generation().load(std::memory_order_relaxed))
+                reseed();
+        }
+
+        // Wydanie n bajtów z bufora; wydane bajty nie zostają w buforze.
+        void take(u8* const dst, size_t const n) noexcept {
+            auto const src = buffer_ + BUFFER_SIZE - available_;
+            std::memcpy(dst, src, n);
+            std::memset(src, 0, n);
+            available_ -= n;
+        }
+
+        void refill() noexcept {
+            reseed_if_needed();
+
+            for (size_t i = 0; i < BUFFER_BLOCKS; ++i)
+                chacha20_block(key_, i, buffer_ + i * BLOCK_SIZE);
+
+            // Pierwsze 32 bajty - nowy klucz, reszta do wydania.
+            load_le32(buffer_, key_);
+            std::memset(buffer_, 0, KEY_SIZE);
+            available_ = BUFFER_SIZE - KEY_SIZE;
+            generated_ += available_;
+        }
+
+        // Generowanie nbytes (wielokrotność BLOCK_SIZE) bezpośrednio do dst.
+        // Z bieżącego klucza wyprowadzamy blok: połowa to następny klucz generatora,
+        // druga połowa to jednorazowy klucz strumienia dla tego żądania.
+        void generate(u8* dst, size_t nbytes) noexcept {
+            while (nbytes) {
+                reseed_if_needed();
+
+                u8 block[BLOCK_SIZE];
+                u32 stream_key[KEY_SIZE / sizeof(u32)];
+                chacha20_block(key_, 0, block);
+                load_le32(block, key_);
+                load_le32(block + KEY_SIZE, stream_key);
+
+                // Ograniczenie długości jednego strumienia do odstępu między reseed.
+                auto const n = std::min<size_t>(nbytes, RESEED_INTERVAL);
+                auto const blocks = n / BLOCK_SIZE;
+                size_t i = 0;
+                for (; i + 4 <= blocks; i += 4)
+                    chacha20_block4(stream_key, i, dst + i * BLOCK_SIZE);
+                for (; i < blocks; ++i)
+                    chacha20_block(stream_key, i, dst + i * BLOCK_SIZE);
+
+                std::memset(block, 0, sizeof(block));
+                std::memset(stream_key, 0, sizeof(stream_key));
+                __asm__ __volatile__("" : : "r"(block), "r"(stream_key) : "memory");
+
+                generated_ += n;
+                dst += n;
+                nbytes -= n;
+            }
+        }
+    };
+}
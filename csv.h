@@ -0,0 +1,323 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Created by piotr on 18.10.26.
+#pragma once
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "types.h"
+#include "simd.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <istream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// Strumieniowy parser CSV/TSV zgodny z RFC 4180: pola w cudzysłowach, podwojone cudzysłowy,
+// delimitery i końce linii wewnątrz cudzysłowów, puste pola, końce linii "\n" i "\r\n".
+// Struktura tekstu wyznaczana jest maskami dla 64-bajtowych porcji (simd::mask64):
+// obszar wewnątrz cudzysłowów to prefiksowy xor maski cudzysłowów, a granice pól
+// to delimitery i końce linii spoza tego obszaru.
+// Pola są widokami na przetwarzany tekst - bez kopiowania.
+namespace bee::csv {
+    struct dialect {
+        char delimiter{','};
+        char quote{'"'};
+    };
+
+    constexpr dialect CSV{};
+    constexpr dialect TSV{'\t'};
+
+    /// Pole rekordu. Dla pola w cudzysłowach 'text' to zawartość bez otaczających cudzysłowów,
+    /// a podwojone cudzysłowy wewnątrz pozostają bez zmian (escaped == true, patrz unescape).
+    struct field {
+        std::string_view text{};
+        bool quoted{};
+        bool escaped{};
+    };
+
+    /// Zawartość pola z podwojonymi cudzysłowami zamienionymi na pojedyncze.
+    inline std::string unescape(field const& f, char const quote = '"') {
+        if (!f.escaped)
+            return std::string{f.text};
+
+        std::string out;
+        out.reserve(f.text.size());
+        for (size_t i = 0; i < f.text.size(); ++i) {
+            out += f.text[i];
+            if (f.text[i] == quote && i + 1 < f.text.size() && f.text[i + 1] == quote)
+                ++i;
+        }
+        return out;
+    }
+
+    /// Rekord (wiersz) - pola są ważne tylko w trakcie wywołania funkcji obsługi rekordu.
+    class record {
+        std::span<field const> fields_;
+    public:
+        explicit record(std::span<field const> const fields) noexcept : fields_{fields} {}
+
+        [[nodiscard]] size_t size() const noexcept { return fields_.size(); }
+        [[nodiscard]] field const& operator[](size_t const i) const noexcept { return fields_[i]; }
+        [[nodiscard]] auto begin() const noexcept { return fields_.begin(); }
+        [[nodiscard]] auto end() const noexcept { return fields_.end(); }
+    };
+
+    namespace detail {
+        // Bit i wyniku to xor bitów 0..i argumentu.
+        constexpr u64 prefix_xor(u64 x) noexcept {
+            x ^= x << 1;
+            x ^= x << 2;
+            x ^= x << 4;
+            x ^= x << 8;
+            x ^= x << 16;
+            x ^= x << 32;
+            return x;
+        }
+
+        inline field make_field(std::string_view raw, char const quote) noexcept {
+            if (raw.size() >= 2 && raw.front() == quote && raw.back() == quote) {
+                raw = raw.substr(1, raw.size() - 2);
+                return {raw, true, std::memchr(raw.data(), quote, raw.size()) != nullptr};
+            }
+            return {raw};
+        }
+
+        // Podział tekstu na rekordy - fn(record) dla każdego z nich; puste linie są pomijane.
+        // Stan (pozycja, cudzysłów, separatory bieżącego rekordu) przechowywany jest między
+        // wywołaniami scan, więc tekst czytany porcjami klasyfikowany jest tylko raz,
+        // także gdy jeden rekord (np. długie pole w cudzysłowach) obejmuje wiele porcji.
+        class scanner {
+            dialect d_;
+            size_t pos_{};                      // pierwszy niesklasyfikowany bajt
+            size_t record_start_{};
+            bool inside_{};                     // czy pos_ leży wewnątrz cudzysłowu
+            std::vector<size_t> delimiters_;    // pozycje separatorów pól bieżącego rekordu
+            std::vector<field> fields_;
+        public:
+            explicit scanner(dialect const d) noexcept : d_{d} {}
+
+            // Tekst musi zaczynać się od początku rekordu; przy kolejnym wywołaniu jest to tekst
+            // z poprzedniego wywołania bez zwróconej liczby początkowych bajtów, z dopisaną dalszą częścią.
+            // Gdy !final, niedokończony rekord na końcu tekstu czeka na dalszą część danych.
+            // Zwraca liczbę przetworzonych bajtów, czyli początek pierwszego nieprzetworzonego rekordu.
+            template<typename Fn>
+            size_t scan(std::string_view const data, bool const final, Fn&& fn) {
+                auto const p = data.data();
+                auto const n = data.size();
+
+                auto const end_record = [&](size_t const pos) {
+                    fields_.clear();
+                    auto start = record_start_;
+                    for (auto const delimiter : delimiters_) {
+                        fields_.push_back(make_field(data.substr(start, delimiter - start), d_.quote));
+                        start = delimiter + 1;
+                    }
+                    auto raw = data.substr(start, pos - start);
+                    if (raw.ends_with('\r'))
+                        raw.remove_suffix(1);
+                    if (!fields_.empty() || !raw.empty()) {
+                        fields_.push_back(make_field(raw, d_.quote));
+                        fn(record{fields_});
+                    }
+                    delimiters_.clear();
+                    record_start_ = pos + 1;
+                };
+                auto const boundary = [&](size_t const pos) {
+                    if (p[pos] == '\n')
+                        end_record(pos);
+                    else
+                        delimiters_.push_back(pos);
+                };
+
+                // 'inside' - same jedynki, gdy poprzednia porcja skończyła się wewnątrz cudzysłowu.
+                u64 inside = inside_ ? ~u64{0} : 0;
+                auto i = pos_;
+                for (; i + simd::CHUNK <= n; i += simd::CHUNK) {
+                    auto const in = prefix_xor(simd::mask64(p + i, d_.quote)) ^ inside;
+                    inside = 0 - (in >> 63);
+                    auto const structure = simd::mask64(p + i, d_.delimiter) | simd::mask64(p + i, '\n');
+                    for (auto m = structure & ~in; m; m &= m - 1)
+                        boundary(i + static_cast<size_t>(std::countr_zero(m)));
+                }
+                auto in = inside != 0;
+                for (; i < n; ++i) {
+                    if (p[i] == d_.quote)
+                        in = !in;
+                    else if (!in && (p[i] == d_.delimiter || p[i] == '\n'))
+                        boundary(i);
+                }
+
+                if (final) {
+                    if (record_start_ < n)
+                        end_record(n);
+                    pos_ = record_start_ = 0;
+                    inside_ = false;
+                    delimiters_.clear();
+                    return n;
+                }
+
+                // Przetworzone rekordy znikają z początku tekstu - pozycje liczymy od nowa.
+                auto const consumed = record_start_;
+                pos_ = n - consumed;
+                record_start_ = 0;
+                inside_ = in;
+                for (auto& delimiter : delimiters_)
+                    delimiter -= consumed;
+                return consumed;
+            }
+        };
+
+        // Wykonanie job(k) dla k = 0..n-1 w osobnych wątkach (job(0) w bieżącym);
+        // jeśli wątku nie da się utworzyć, zadanie wykonywane jest na miejscu.
+        template<typename Job>
+        void run_parallel(size_t const n, Job const& job) {
+            std::vector<std::thread> workers;
+            workers.reserve(n - 1);
+            for (size_t k = 1; k < n; ++k) {
+                try {
+                    workers.emplace_back(job, k);
+                }
+                catch (std::system_error const&) {
+                    job(k);
+                }
+            }
+            job(0);
+            for (auto& w : workers)
+                w.join();
+        }
+    }
+
+    /// Przetworzenie całego tekstu (np. odwzorowanego pliku) - fn(record) dla każdego rekordu.
+    /// \code
+    /// if (auto const file = file::mapped_file::open("data.csv"))
+    ///     csv::for_each(file->view(), csv::CSV, [](csv::record const& r) { ... });
+    /// \endcode
+    /// \return Liczba rekordów.
+    template<typename Fn>
+    size_t for_each(std::string_view const data, dialect const d, Fn&& fn) {
+        size_t count = 0;
+        detail::scanner{d}.scan(data, true, [&](record const& r) {
+            ++count;
+            fn(r);
+        });
+        return count;
+    }
+
+    /// Przetworzenie strumienia czytanego porcjami po chunk_size bajtów.
+    /// W pamięci jest tylko bieżąca porcja i niedokończony rekord z poprzedniej.
+    /// \return Liczba rekordów.
+    template<typename Fn>
+    size_t for_each(std::istream& in, dialect const d, Fn&& fn, size_t const chunk_size = size_t{1} << 20) {
+        std::vector<char> buffer;
+        detail::scanner scanner{d};
+        size_t used = 0;
+        size_t count = 0;
+        auto const counted = [&](record const& r) {
+            ++count;
+            fn(r);
+        };
+
+        for (;;) {
+            if (buffer.size() < used + chunk_size)
+                buffer.resize(used + chunk_size);
+            in.read(buffer.data() + used, static_cast<std::streamsize>(chunk_size));
+            auto const got = static_cast<size_t>(in.gcount());
+            used += got;
+
+            auto const final = got < chunk_size;
+            auto const consumed = scanner.scan({buffer.data(), used}, final, counted);
+            if (final)
+                break;
+            // Niedokończony rekord przenosimy na początek bufora (tylko gdy coś przetworzono -
+            // rekord obejmujący wiele porcji nie jest kopiowany przy każdym doczytaniu).
+            if (consumed) {
+                std::memmove(buffer.data(), buffer.data() + consumed, used - consumed);
+                used -= consumed;
+            }
+        }
+        return count;
+    }
+
+    /// Równoległe przetwarzanie tekstu (np. odwzorowanego pliku).
+    /// Tekst dzielony jest na części na granicach rekordów: liczby cudzysłowów w częściach
+    /// (liczone równolegle) dają parzystość na początku każdej części, więc wiadomo,
+    /// czy początek leży w cudzysłowie - granicą jest pierwszy koniec linii poza cudzysłowem.
+    /// fn(part, record) wywoływana jest współbieżnie z różnych wątków;
+    /// w obrębie jednej części rekordy przychodzą po kolei.
+    /// \return Liczba rekordów.
+    template<typename Fn>
+    size_t for_each_parallel(std::string_view const data, dialect const d, Fn&& fn,
+                             unsigned const threads = std::thread::hardware_concurrency())
+    {
+        constexpr size_t MIN_PART = size_t{1} << 16;
+        auto const n = data.size();
+        auto const parts = std::clamp<size_t>(std::min<size_t>(threads, n / MIN_PART), 1, 256);
+        auto const step = n / parts;
+
+        std::vector<size_t> quotes(parts);
+        detail::run_parallel(parts, [&](size_t const k) {
+            auto const begin = k * step;
+            auto const end = k + 1 == parts ? n : begin + step;
+            quotes[k] = simd::count_byte(data.data() + begin, end - begin, d.quote);
+        });
+
+        std::vector<size_t> bounds(parts + 1, n);
+        bounds[0] = 0;
+        bool in = false;
+        for (size_t k = 1; k < parts; ++k) {
+            in ^= quotes[k - 1] & 1;
+            // Poprzednia granica leży za początkiem tej części - część jest pusta.
+            if (bounds[k - 1] >= k * step) {
+                bounds[k] = bounds[k - 1];
+                continue;
+            }
+            auto pos = k * step;
+            for (bool q = in; pos < n; ++pos) {
+                if (data[pos] == d.quote)
+                    q = !q;
+                else if (!q && data[pos] == '\n')
+                    break;
+            }
+            bounds[k] = std::min(pos + 1, n);
+        }
+
+        std::vector<size_t> counts(parts);
+        detail::run_parallel(parts, [&](size_t const k) {
+            detail::scanner{d}.scan(data.substr(bounds[k], bounds[k + 1] - bounds[k]), true, [&](record const& r) {
+                ++counts[k];
+                fn(k, r);
+            });
+        });
+
+        size_t count = 0;
+        for (auto const c : counts)
+            count += c;
+        return count;
+    }
+}
@@ -32,6 +32,13 @@
 #include <format>
 #include <fstream>
 #include <iostream>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace bee::file {
     static std::optional<std::vector<char>> read_binary(std::string const& fpath) {
@@ -85,4 +92,61 @@ namespace bee::file {
         return {};
     }
 
+    /// Plik odwzorowany w pamięci (tylko do odczytu).
+    /// Zawartość dostępna jest jako widok bez kopiowania; strony wczytuje system przy pierwszym dostępie.
+    class mapped_file final {
+        void* data_{};
+        size_t size_{};
+
+        mapped_file(void* const data, size_t const size) noexcept : data_{data}, size_{size} {}
+    public:
+        mapped_file(mapped_file&& other) noexcept
+            : data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)} {}
+        mapped_file(mapped_file const&) = delete;
+        mapped_file& operator=(mapped_file const&) = delete;
+        mapped_file& operator=(mapped_file&&) = delete;
+
+        ~mapped_file() {
+            if (data_)
+                munmap(data_, size_);
+        }
+
+        /// Odwzorowanie pliku w pamięci.
+        /// \param fpath Ścieżka do pliku,
+        /// \param sequential Czy plik będzie czytany sekwencyjnie (wskazówka dla systemu).
+        /// \return Obiekt pliku lub nic w przypadku błędu.
+        static std::optional<mapped_file> open(std::string const& fpath, bool const sequential = true) noexcept {
+            auto const fd = ::open(fpath.c_str(), O_RDONLY);
+            if (fd == -1) {
+                std::cerr << strerror(errno) << std::endl;
+                return {};
+            }
+            struct stat st{};
+            if (fstat(fd, &st) == -1) {
+                std::cerr << strerror(errno) << std::endl;
+                close(fd);
+                return {};
+            }
+            // Pustego pliku nie da się odwzorować - wystarczy pusty widok.
+            auto const size = static_cast<size_t>(st.st_size);
+            if (size == 0) {
+                close(fd);
+                return mapped_file{nullptr, 0};
+            }
+            auto const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (data == MAP_FAILED) {
+                std::cerr << strerror(errno) << std::endl;
+                return {};
+            }
+            if (sequential)
+                madvise(data, size, MADV_SEQUENTIAL);
+            return mapped_file{data, size};
+        }
+
+        [[nodiscard]] std::string_view view() const noexcept {
+            return {static_cast<char const*>(data_), size_};
+        }
+        [[nodiscard]] size_t size() const noexcept { return size_; }
+    };
 }
@@ -0,0 +1,352 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Created by piotr on 18.10.26.
+#pragma once
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "types.h"
+#include "simd.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstring>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+// Sumy kontrolne i szybkie (niekryptograficzne) funkcje skrótu.
+namespace bee::hash {
+    /****************************************************************
+    *                        C R C 3 2 C                            *
+    ****************************************************************/
+
+    namespace detail {
+        constexpr u32 CRC32C_POLY = 0x82f63b78;    // Castagnoli, odwrócona kolejność bitów
+
+        // Tablice dla metody 'slicing-by-8': t[k][v] to CRC bajtu v, po którym następuje k bajtów zerowych.
+        constexpr auto make_crc32c_tables() noexcept {
+            std::array<std::array<u32, 256>, 8> t{};
+            for (u32 i = 0; i < 256; ++i) {
+                u32 c = i;
+                for (int j = 0; j < 8; ++j)
+                    c = (c & 1) ? (c >> 1) ^ CRC32C_POLY : c >> 1;
+                t[0][i] = c;
+            }
+            for (size_t k = 1; k < 8; ++k)
+                for (size_t i = 0; i < 256; ++i)
+                    t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xff];
+            return t;
+        }
+
+        inline constexpr auto crc32c_tables = make_crc32c_tables();
+
+        // Surowy rejestr CRC (bez negacji na wejściu i wyjściu).
+        inline u32 crc32c_sw(u32 crc, u8 const* p, size_t n) noexcept {
+            auto const& t = crc32c_tables;
+            for (; n >= 8; p += 8, n -= 8) {
+                auto const v = load_le64(p) ^ crc;
+                crc = t[7][v & 0xff] ^ t[6][(v >> 8) & 0xff] ^ t[5][(v >> 16) & 0xff] ^ t[4][(v >> 24) & 0xff]
+                    ^ t[3][(v >> 32) & 0xff] ^ t[2][(v >> 40) & 0xff] ^ t[1][(v >> 48) & 0xff] ^ t[0][v >> 56];
+            }
+            for (; n; ++p, --n)
+                crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xff];
+            return crc;
+        }
+
+#if defined(__x86_64__)
+        // Instrukcja crc32 ma opóźnienie 3 cykli przy przepustowości 1/cykl, więc duże dane
+        // liczymy w trzech niezależnych pasmach po LANE bajtów i łączymy wyniki:
+        // crc(A || B) = shift(crc(A)) ^ crc(B), gdzie shift dopisuje LANE bajtów zerowych.
+        constexpr size_t CRC32C_LANE = 1024;
+
+        __attribute__((target("sse4.2")))
+        inline u32 crc32c_zeros_hw(u64 crc) noexcept {
+            for (size_t i = 0; i < CRC32C_LANE / 8; ++i)
+                crc = _mm_crc32_u64(crc, 0);
+            return static_cast<u32>(crc);
+        }
+
+        // Operator 'shift' jest liniowy, więc wystarczą tablice dla każdego bajtu rejestru.
+        struct crc32c_shift {
+            u32 t[4][256];
+
+            crc32c_shift() noexcept {
+                for (u32 k = 0; k < 4; ++k)
+                    for (u32 v = 0; v < 256; ++v)
+                        t[k][v] = crc32c_zeros_hw(u64{v} << (8 * k));
+            }
+
+            u32 operator()(u32 const crc) const noexcept {
+                return t[0][crc & 0xff] ^ t[1][(crc >> 8) & 0xff] ^ t[2][(crc >> 16) & 0xff] ^ t[3][crc >> 24];
+            }
+        };
+
+        __attribute__((target("sse4.2")))
+        inline u32 crc32c_hw(u32 const crc, u8 const* p, size_t n) noexcept {
+            u64 a = crc;
+            if (n >= 3 * CRC32C_LANE) {
+                static crc32c_shift const shift{};
+                do {
+                    u64 b = 0, c = 0;
+                    for (size_t i = 0; i < CRC32C_LANE; i += 8) {
+                        a = _mm_crc32_u64(a, load_le64(p + i));
+                        b = _mm_crc32_u64(b, load_le64(p + CRC32C_LANE + i));
+                        c = _mm_crc32_u64(c, load_le64(p + 2 * CRC32C_LANE + i));
+                    }
+                    a = shift(shift(static_cast<u32>(a)) ^ static_cast<u32>(b)) ^ static_cast<u32>(c);
+                    p += 3 * CRC32C_LANE;
+                    n -= 3 * CRC32C_LANE;
+                } while (n >= 3 * CRC32C_LANE);
+            }
+            for (; n >= 8; p += 8, n -= 8)
+                a = _mm_crc32_u64(a, load_le64(p));
+            auto v = static_cast<u32>(a);
+            for (; n; ++p, --n)
+                v = _mm_crc32_u8(v, *p);
+            return v;
+        }
+
+        inline bool has_sse42() noexcept {
+            static bool const supported = __builtin_cpu_supports("sse4.2");
+            return supported;
+        }
+#endif
+    }
+
+    /// CRC-32C (Castagnoli, jak w iSCSI, ext4, SCTP).
+    /// Na x86-64 z SSE4.2 liczone instrukcją crc32, w przeciwnym razie programowo.
+    /// Dane można przetwarzać porcjami: crc32c(b, nb, crc32c(a, na)) == crc32c(a || b).
+    inline u32 crc32c(void const* const data, size_t const nbytes, u32 const crc = 0) noexcept {
+        auto const p = static_cast<u8 const*>(data);
+#if defined(__x86_64__)
+        if (detail::has_sse42())
+            return ~detail::crc32c_hw(~crc, p, nbytes);
+#endif
+        return ~detail::crc32c_sw(~crc, p, nbytes);
+    }
+
+    inline u32 crc32c(BytesView auto const data, u32 const crc = 0) noexcept
+        requires requires { data.data(); data.size(); }
+    {
+        return crc32c(data.data(), data.size(), crc);
+    }
+
+    /****************************************************************
+    *                        H A S H 6 4                            *
+    ****************************************************************/
+
+    // 64-bitowy skrót z rodziny wyhash/komihash: mnożenie 64x64->128 i złożenie połówek.
+    // Dane do 16 bajtów - jedna ścieżka bez pętli; dłuższe - pasy po 48 bajtów
+    // w trzech niezależnych torach, ostatni (niepełny) pas uzupełniony zerami.
+    namespace detail {
+        constexpr u64 S0 = 0xa0761d6478bd642f;
+        constexpr u64 S1 = 0xe7037ed1a0b428db;
+        constexpr u64 S2 = 0x8ebc6af09c88c6e3;
+        constexpr u64 S3 = 0x589965cc75374cc3;
+        constexpr size_t STRIPE = 48;
+
+        constexpr u64 mix(u64 const a, u64 const b) noexcept {
+            auto const r = static_cast<unsigned __int128>(a) * b;
+            return static_cast<u64>(r) ^ static_cast<u64>(r >> 64);
+        }
+
+        constexpr u64 init(u64 const seed) noexcept {
+            return seed ^ mix(seed ^ S0, S1);
+        }
+
+        inline u64 short_hash(u8 const* const p, size_t const n, u64 const seed) noexcept {
+            u64 a = 0, b = 0;
+            if (n >= 4) {
+                auto const d = (n >> 3) << 2;
+                a = u64{load_le32(p)} << 32 | load_le32(p + d);
+                b = u64{load_le32(p + n - 4)} << 32 | load_le32(p + n - 4 - d);
+            }
+            else if (n)
+                a = u64{p[0]} << 16 | u64{p[n >> 1]} << 8 | p[n - 1];
+            return mix(S1 ^ n, mix(a ^ S1, b ^ seed));
+        }
+
+        inline void stripe(u64 (&lane)[3], u8 const* const p) noexcept {
+            lane[0] = mix(load_le64(p) ^ S1, load_le64(p + 8) ^ lane[0]);
+            lane[1] = mix(load_le64(p + 16) ^ S2, load_le64(p + 24) ^ lane[1]);
+            lane[2] = mix(load_le64(p + 32) ^ S3, load_le64(p + 40) ^ lane[2]);
+        }
+
+        inline u64 finish(u64 const (&lane)[3], u64 const n, u64 const seed) noexcept {
+            return mix(S1 ^ n, mix(lane[0] ^ lane[1] ^ S1, lane[2] ^ seed));
+        }
+    }
+
+    /// Szybki 64-bitowy skrót danych (nie nadaje się do zastosowań kryptograficznych).
+    inline u64 hash64(void const* const data, size_t n, u64 seed = 0) noexcept {
+        using namespace detail;
+        auto p = static_cast<u8 const*>(data);
+        seed = init(seed);
+        if (n <= 16)
+            return short_hash(p, n, seed);
+
+        auto const total = n;
+        u64 lane[3]{seed, seed ^ S2, seed ^ S3};
+        for (; n > STRIPE; p += STRIPE, n -= STRIPE)
+            stripe(lane, p);
+        u8 last[STRIPE]{};
+        std::memcpy(last, p, n);
+        stripe(lane, last);
+        return finish(lane, total, seed);
+    }
+
+    inline u64 hash64(BytesView auto const data, u64 const seed = 0) noexcept
+        requires requires { data.data(); data.size(); }
+    {
+        return hash64(data.data(), data.size(), seed);
+    }
+
+    /// Skrót hash64 liczony porcjami; wynik jest identyczny z hash64 dla połączonych danych.
+    class hash64_state final {
+        u64 seed_;
+        u64 lane_[3];
+        u8 buffer_[detail::STRIPE]{};
+        size_t buffered_{};
+        u64 total_{};
+    public:
+        explicit hash64_state(u64 const seed = 0) noexcept
+            : seed_{detail::init(seed)}, lane_{seed_, seed_ ^ detail::S2, seed_ ^ detail::S3} {}
+
+        void update(void const* const data, size_t n) noexcept {
+            using detail::STRIPE;
+            auto p = static_cast<u8 const*>(data);
+            total_ += n;
+
+            // Pełny pas przetwarzamy dopiero, gdy wiadomo, że nie jest ostatnim.
+            if (buffered_) {
+                auto const k = std::min(n, STRIPE - buffered_);
+                std::memcpy(buffer_ + buffered_, p, k);
+                buffered_ += k;
+                p += k;
+                n -= k;
+                if (n == 0)
+                    return;
+                detail::stripe(lane_, buffer_);
+                buffered_ = 0;
+            }
+            for (; n > STRIPE; p += STRIPE, n -= STRIPE)
+                detail::stripe(lane_, p);
+            std::memcpy(buffer_, p, n);
+            buffered_ = n;
+        }
+
+        void update(BytesView auto const data) noexcept {
+            update(data.data(), data.size());
+        }
+
+        /// Skrót dotychczasowych danych (stan się nie zmienia, można dodawać kolejne porcje).
+        [[nodiscard]] u64 digest() const noexcept {
+            if (total_ <= 16)
+                return detail::short_hash(buffer_, total_, seed_);
+            u64 lane[3]{lane_[0], lane_[1], lane_[2]};
+            u8 last[detail::STRIPE]{};
+            std::memcpy(last, buffer_, buffered_);
+            detail::stripe(lane, last);
+            return detail::finish(lane, total_, seed_);
+        }
+    };
+
+    /****************************************************************
+    *                        H A S H E R                            *
+    ****************************************************************/
+
+    /// Zamiennik std::hash dla tablic mieszających (std::unordered_map itp.).
+    /// Przezroczysty: std::string, std::string_view i const char* dają ten sam skrót,
+    /// więc z std::equal_to<> wyszukiwanie nie tworzy tymczasowych napisów.
+    /// Liczby całkowite, wyliczenia i wskaźniki - jedno mnożenie zamiast tożsamości z std::hash.
+    struct hasher {
+        using is_transparent = void;
+
+        u64 seed{};
+
+        size_t operator()(std::string_view const text) const noexcept {
+            return hash64(text.data(), text.size(), seed);
+        }
+
+        template<typename T>
+            requires ((std::integral<T> || std::is_enum_v<T> || std::is_pointer_v<T>)
+                      && !std::is_convertible_v<T, std::string_view>)
+        size_t operator()(T const v) const noexcept {
+            u64 x;
+            if constexpr (std::is_pointer_v<T>)
+                x = reinterpret_cast<std::uintptr_t>(v);
+            else if constexpr (std::is_enum_v<T>)
+                x = static_cast<u64>(static_cast<std::underlying_type_t<T>>(v));
+            else
+                x = static_cast<u64>(v);
+            return detail::mix(x ^ detail::S1, seed ^ detail::S0);
+        }
+
+        /// Ciągłe zakresy typów bez bitów wypełnienia (np. std::vector<int>, std::array<u8, N>).
+        template<std::ranges::contiguous_range R>
+            requires (std::has_unique_object_representations_v<std::ranges::range_value_t<R>>
+                      && !std::is_convertible_v<R const&, std::string_view>)
+        size_t operator()(R const& range) const noexcept {
+            return hash64(std::ranges::data(range), std::ranges::size(range) * sizeof(std::ranges::range_value_t<R>), seed);
+        }
+    };
+
+    /// Skrót tekstu bez rozróżniania wielkości liter ASCII - do pary z ci_equal:
+    /// std::unordered_map<std::string, T, hash::ci_hasher, hash::ci_equal>.
+    /// Tekst zamieniany jest na małe litery porcjami w buforze na stosie (bez alokacji);
+    /// wynik jest równy hash64 tekstu zapisanego małymi literami.
+    struct ci_hasher {
+        using is_transparent = void;
+
+        u64 seed{};
+
+        size_t operator()(std::string_view const text) const noexcept {
+            constexpr size_t BUFFER_SIZE = 256;
+            u8 buffer[BUFFER_SIZE];
+            if (text.size() <= BUFFER_SIZE) {
+                simd::ascii_lower(text.data(), buffer, text.size());
+                return hash64(buffer, text.size(), seed);
+            }
+            hash64_state state{seed};
+            for (size_t i = 0; i < text.size(); i += BUFFER_SIZE) {
+                auto const n = std::min(BUFFER_SIZE, text.size() - i);
+                simd::ascii_lower(text.data() + i, buffer, n);
+                state.update(buffer, n);
+            }
+            return state.digest();
+        }
+    };
+
+    /// Równość tekstów bez rozróżniania wielkości liter ASCII (przezroczysta).
+    struct ci_equal {
+        using is_transparent = void;
+
+        bool operator()(std::string_view const a, std::string_view const b) const noexcept {
+            return a.size() == b.size() && simd::mismatch_icase(a.data(), b.data(), a.size()) == a.size();
+        }
+    };
+}
@@ -0,0 +1,528 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Created by piotr on 18.10.26.
+#pragma once
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "types.h"
+#include <bit>
+#include <cstring>
+#include <string_view>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// Wektorowe wyszukiwanie bajtów w tekście (separatory pól, końce linii).
+// Wariant jądra (SSE2, AVX2 lub AVX-512BW) wybierany jest raz, przy pierwszym użyciu,
+// na podstawie możliwości procesora; na innych architekturach - wersja skalarna.
+namespace bee::simd {
+    constexpr size_t CHUNK = 64;
+
+    /// Zbiór bajtów (np. kilku delimiterów) - 256-bitowa tablica przynależności.
+    /// Układ tablicy pozwala na dopasowanie wektorowe (pshufb): bajt b = (hi << 4 | lo)
+    /// należy do zbioru, gdy w rows_[lo + 16 * (hi >> 3)] ustawiony jest bit (hi & 7).
+    class byte_set {
+        alignas(16) u8 rows_[32]{};
+    public:
+        constexpr byte_set() noexcept = default;
+        constexpr explicit byte_set(std::string_view const chars) noexcept {
+            for (auto const c : chars)
+                insert(c);
+        }
+
+        constexpr void insert(char const c) noexcept {
+            auto const b = static_cast<u8>(c);
+            rows_[(b & 15) + 16 * (b >> 7)] |= static_cast<u8>(1u << ((b >> 4) & 7));
+        }
+        [[nodiscard]] constexpr bool contains(char const c) const noexcept {
+            auto const b = static_cast<u8>(c);
+            return rows_[(b & 15) + 16 * (b >> 7)] & (1u << ((b >> 4) & 7));
+        }
+        [[nodiscard]] u8 const* rows() const noexcept { return rows_; }
+    };
+
+    /// Białe znaki jak std::isspace w locale "C": spacja, \t, \n, \v, \f, \r.
+    inline constexpr byte_set SPACE{" \t\n\v\f\r"};
+
+    constexpr bool is_space(char const c) noexcept {
+        return SPACE.contains(c);
+    }
+
+    /// Wielka litera ASCII zamieniona na małą; pozostałe bajty bez zmian.
+    constexpr u8 fold_ascii(u8 const c) noexcept {
+        return static_cast<u8>(c - 'A') < 26 ? c | 0x20 : c;
+    }
+
+    namespace detail {
+        struct kernels {
+            u64 (*mask64)(u8 const*, u8) noexcept;
+            size_t (*find)(u8 const*, size_t, u8) noexcept;
+            size_t (*count)(u8 const*, size_t, u8) noexcept;
+            u64 (*mask64_any)(u8 const*, byte_set const&) noexcept;
+            void (*flip_case)(u8 const*, u8*, size_t, u8) noexcept;
+            size_t (*mismatch_icase)(u8 const*, u8 const*, size_t) noexcept;
+        };
+
+        inline u64 mask64_scalar(u8 const* const p, u8 const c) noexcept {
+            u64 m = 0;
+            for (size_t i = 0; i < CHUNK; ++i)
+                m |= u64{p[i] == c} << i;
+            return m;
+        }
+
+        inline size_t find_scalar(u8 const* const p, size_t const n, u8 const c) noexcept {
+            auto const hit = static_cast<u8 const*>(std::memchr(p, c, n));
+            return hit ? static_cast<size_t>(hit - p) : n;
+        }
+
+        inline size_t count_scalar(u8 const* const p, size_t const n, u8 const c) noexcept {
+            size_t k = 0;
+            for (size_t i = 0; i < n; ++i)
+                k += p[i] == c;
+            return k;
+        }
+
+        inline u64 mask64_any_scalar(u8 const* const p, byte_set const& set) noexcept {
+            u64 m = 0;
+            for (size_t i = 0; i < CHUNK; ++i)
+                m |= u64{set.contains(static_cast<char>(p[i]))} << i;
+            return m;
+        }
+
+        // Zmiana wielkości liter ASCII: bajty z zakresu first..first+25 ('A'..'Z' lub 'a'..'z')
+        // mają zamieniany bit 0x20. Źródło i cel mogą być tym samym buforem.
+        inline void flip_case_scalar(u8 const* const src, u8* const dst, size_t const n, u8 const first) noexcept {
+            for (size_t i = 0; i < n; ++i)
+                dst[i] = src[i] ^ (static_cast<u8>(src[i] - first) < 26 ? 0x20 : 0);
+        }
+
+        // Pozycja pierwszej różnicy bez rozróżniania wielkości liter ASCII lub n.
+        inline size_t mismatch_icase_scalar(u8 const* const a, u8 const* const b, size_t const n) noexcept {
+            for (size_t i = 0; i < n; ++i)
+                if (fold_ascii(a[i]) != fold_ascii(b[i]))
+                    return i;
+            return n;
+        }
+
+        // Wspólny szkielet: pełne 64-bajtowe porcje jądrem, reszta skalarnie.
+        template<u64 (*Mask)(u8 const*, u8) noexcept>
+        size_t find_with(u8 const* const p, size_t const n, u8 const c) noexcept {
+            size_t i = 0;
+            for (; i + CHUNK <= n; i += CHUNK)
+                if (auto const m = Mask(p + i, c))
+                    return i + static_cast<size_t>(std::countr_zero(m));
+            for (; i < n; ++i)
+                if (p[i] == c)
+                    return i;
+            return n;
+        }
+
+        template<u64 (*Mask)(u8 const*, u8) noexcept>
+        size_t count_with(u8 const* const p, size_t const n, u8 const c) noexcept {
+            size_t i = 0, k = 0;
+            for (; i + CHUNK <= n; i += CHUNK)
+                k += static_cast<size_t>(std::popcount(Mask(p + i, c)));
+            return k + count_scalar(p + i, n - i, c);
+        }
+
+#if defined(__x86_64__)
+        // SSE2 jest zawsze dostępne na x86-64.
+        inline u64 mask64_sse2(u8 const* const p, u8 const c) noexcept {
+            auto const needle = _mm_set1_epi8(static_cast<char>(c));
+            u64 m = 0;
+            for (int k = 0; k < 4; ++k) {
+                auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + 16 * k));
+                m |= u64{static_cast<u16>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)))} << (16 * k);
+            }
+            return m;
+        }
+
+        __attribute__((target("avx2")))
+        inline u64 mask64_avx2(u8 const* const p, u8 const c) noexcept {
+            auto const needle = _mm256_set1_epi8(static_cast<char>(c));
+            auto const lo = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+            auto const hi = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + 32));
+            auto const mlo = static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle)));
+            auto const mhi = static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle)));
+            return u64{mhi} << 32 | mlo;
+        }
+
+        __attribute__((target("avx512f,avx512bw")))
+        inline u64 mask64_avx512(u8 const* const p, u8 const c) noexcept {
+            auto const v = _mm512_loadu_si512(p);
+            return _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(static_cast<char>(c)));
+        }
+
+        // Przesunięcie o (0x80 - first) przenosi zakres liter na początek zakresu ze znakiem
+        // (-128..-103), więc wystarcza jedno porównanie ze znakiem.
+        inline void flip_case_sse2(u8 const* const src, u8* const dst, size_t const n, u8 const first) noexcept {
+            auto const shift = _mm_set1_epi8(static_cast<char>(0x80 - first));
+            auto const limit = _mm_set1_epi8(-128 + 26);
+            auto const bit = _mm_set1_epi8(0x20);
+            size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i));
+                auto const letter = _mm_cmplt_epi8(_mm_add_epi8(v, shift), limit);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(v, _mm_and_si128(letter, bit)));
+            }
+            flip_case_scalar(src + i, dst + i, n - i, first);
+        }
+
+        inline __m128i fold_sse2(__m128i const v) noexcept {
+            auto const letter = _mm_cmplt_epi8(_mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - 'A'))), _mm_set1_epi8(-128 + 26));
+            return _mm_or_si128(v, _mm_and_si128(letter, _mm_set1_epi8(0x20)));
+        }
+
+        inline size_t mismatch_icase_sse2(u8 const* const a, u8 const* const b, size_t const n) noexcept {
+            size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                auto const va = fold_sse2(_mm_loadu_si128(reinterpret_cast<__m128i const*>(a + i)));
+                auto const vb = fold_sse2(_mm_loadu_si128(reinterpret_cast<__m128i const*>(b + i)));
+                if (auto const m = static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb))) ^ 0xffff)
+                    return i + static_cast<size_t>(std::countr_zero(m));
+            }
+            return i + mismatch_icase_scalar(a + i, b + i, n - i);
+        }
+
+        __attribute__((target("avx2")))
+        inline __m256i fold_avx2(__m256i const v) noexcept {
+            auto const letter = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), _mm256_add_epi8(v, _mm256_set1_epi8(static_cast<char>(0x80 - 'A'))));
+            return _mm256_or_si256(v, _mm256_and_si256(letter, _mm256_set1_epi8(0x20)));
+        }
+
+        __attribute__((target("avx2")))
+        inline size_t mismatch_icase_avx2(u8 const* const a, u8 const* const b, size_t const n) noexcept {
+            size_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                auto const va = fold_avx2(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(a + i)));
+                auto const vb = fold_avx2(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(b + i)));
+                if (auto const m = ~static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb))))
+                    return i + static_cast<size_t>(std::countr_zero(m));
+            }
+            return i + mismatch_icase_sse2(a + i, b + i, n - i);
+        }
+
+        __attribute__((target("avx2")))
+        inline void flip_case_avx2(u8 const* const src, u8* const dst, size_t const n, u8 const first) noexcept {
+            auto const shift = _mm256_set1_epi8(static_cast<char>(0x80 - first));
+            auto const limit = _mm256_set1_epi8(-128 + 26);
+            auto const bit = _mm256_set1_epi8(0x20);
+            size_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + i));
+                auto const letter = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(v, shift));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(v, _mm256_and_si256(letter, bit)));
+            }
+            flip_case_sse2(src + i, dst + i, n - i, first);
+        }
+
+        // AVX-512: końcówka ładowana i zapisywana z maską.
+        __attribute__((target("avx512f,avx512bw,bmi2")))
+        inline void flip_case_avx512(u8 const* const src, u8* const dst, size_t const n, u8 const first) noexcept {
+            auto const base = _mm512_set1_epi8(static_cast<char>(first));
+            auto const span = _mm512_set1_epi8(26);
+            auto const bit = _mm512_set1_epi8(0x20);
+            for (size_t i = 0; i < n; i += CHUNK) {
+                auto const valid = n - i >= CHUNK ? ~u64{0} : _bzhi_u64(~u64{0}, static_cast<unsigned>(n - i));
+                auto const v = _mm512_maskz_loadu_epi8(valid, src + i);
+                auto const letter = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(v, base), span);
+                _mm512_mask_storeu_epi8(dst + i, valid, _mm512_mask_blend_epi8(letter, v, _mm512_xor_si512(v, bit)));
+            }
+        }
+
+        __attribute__((target("avx512f,avx512bw")))
+        inline __m512i fold_avx512(__m512i const v) noexcept {
+            auto const letter = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(v, _mm512_set1_epi8('A')), _mm512_set1_epi8(26));
+            return _mm512_mask_blend_epi8(letter, v, _mm512_or_si512(v, _mm512_set1_epi8(0x20)));
+        }
+
+        __attribute__((target("avx512f,avx512bw,bmi2")))
+        inline size_t mismatch_icase_avx512(u8 const* const a, u8 const* const b, size_t const n) noexcept {
+            for (size_t i = 0; i < n; i += CHUNK) {
+                auto const valid = n - i >= CHUNK ? ~u64{0} : _bzhi_u64(~u64{0}, static_cast<unsigned>(n - i));
+                auto const va = fold_avx512(_mm512_maskz_loadu_epi8(valid, a + i));
+                auto const vb = fold_avx512(_mm512_maskz_loadu_epi8(valid, b + i));
+                if (auto const m = _mm512_mask_cmpneq_epi8_mask(valid, va, vb))
+                    return i + static_cast<size_t>(std::countr_zero(m));
+            }
+            return n;
+        }
+
+        // Dopasowanie klasy znaków: młodsza połówka bajtu wybiera wiersz tablicy
+        // (z pierwszej lub drugiej połowy, zależnie od najstarszego bitu bajtu),
+        // starsza połówka - bit w tym wierszu.
+        __attribute__((target("avx2")))
+        inline u64 mask64_any_avx2(u8 const* const p, byte_set const& set) noexcept {
+            auto const rows_lo = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<__m128i const*>(set.rows())));
+            auto const rows_hi = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<__m128i const*>(set.rows() + 16)));
+            auto const bits = _mm256_setr_epi8(
+                1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+            auto const nibble = _mm256_set1_epi8(0x0f);
+            u64 m = 0;
+            for (int k = 0; k < 2; ++k) {
+                auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + 32 * k));
+                auto const lo = _mm256_and_si256(v, nibble);
+                auto const hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+                auto const row = _mm256_blendv_epi8(
+                    _mm256_shuffle_epi8(rows_lo, lo), _mm256_shuffle_epi8(rows_hi, lo), v);
+                auto const hit = _mm256_and_si256(row, _mm256_shuffle_epi8(bits, hi));
+                auto const miss = static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hit, _mm256_setzero_si256())));
+                m |= u64{~miss} << (32 * k);
+            }
+            return m;
+        }
+
+        // AVX-512: ostatnia niepełna porcja ładowana z maską (bez odczytu poza bufor).
+        __attribute__((target("avx512f,avx512bw,bmi2")))
+        inline size_t find_avx512(u8 const* const p, size_t const n, u8 const c) noexcept {
+            auto const needle = _mm512_set1_epi8(static_cast<char>(c));
+            size_t i = 0;
+            for (; i + CHUNK <= n; i += CHUNK)
+                if (auto const m = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(p + i), needle))
+                    return i + static_cast<size_t>(std::countr_zero(m));
+            if (i < n) {
+                auto const valid = _bzhi_u64(~u64{0}, static_cast<unsigned>(n - i));
+                auto const v = _mm512_maskz_loadu_epi8(valid, p + i);
+                if (auto const m = _mm512_mask_cmpeq_epi8_mask(valid, v, needle))
+                    return i + static_cast<size_t>(std::countr_zero(m));
+            }
+            return n;
+        }
+
+        inline kernels select() noexcept {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("bmi2"))
+                return {mask64_avx512, find_avx512, count_with<mask64_avx512>, mask64_any_avx2, flip_case_avx512, mismatch_icase_avx512};
+            if (__builtin_cpu_supports("avx2"))
+                return {mask64_avx2, find_with<mask64_avx2>, count_with<mask64_avx2>, mask64_any_avx2, flip_case_avx2, mismatch_icase_avx2};
+            return {mask64_sse2, find_with<mask64_sse2>, count_with<mask64_sse2>, mask64_any_scalar, flip_case_sse2, mismatch_icase_sse2};
+        }
+#else
+        inline kernels select() noexcept {
+            return {mask64_scalar, find_scalar, count_scalar, mask64_any_scalar, flip_case_scalar, mismatch_icase_scalar};
+        }
+#endif
+
+        inline kernels const& dispatch() noexcept {
+            static kernels const k = select();
+            return k;
+        }
+    }
+
+    /// Maska pozycji bajtu c w 64-bajtowej porcji (bit i ustawiony, gdy p[i] == c).
+    /// Porcja musi mieć pełne 64 bajty.
+    inline u64 mask64(void const* const p, char const c) noexcept {
+        return detail::dispatch().mask64(static_cast<u8 const*>(p), static_cast<u8>(c));
+    }
+
+    /// Pozycja pierwszego wystąpienia bajtu c lub n, jeśli go nie ma.
+    inline size_t find_byte(void const* const p, size_t const n, char const c) noexcept {
+        return detail::dispatch().find(static_cast<u8 const*>(p), n, static_cast<u8>(c));
+    }
+
+    /// Liczba wystąpień bajtu c.
+    inline size_t count_byte(void const* const p, size_t const n, char const c) noexcept {
+        return detail::dispatch().count(static_cast<u8 const*>(p), n, static_cast<u8>(c));
+    }
+
+    /// Zamiana liter ASCII na małe (n bajtów z src do dst; src == dst - w miejscu).
+    /// Bajty spoza 'A'..'Z' (również bajty UTF-8 > 0x7f) pozostają bez zmian.
+    inline void ascii_lower(void const* const src, void* const dst, size_t const n) noexcept {
+        detail::dispatch().flip_case(static_cast<u8 const*>(src), static_cast<u8*>(dst), n, 'A');
+    }
+
+    /// Zamiana liter ASCII na duże (n bajtów z src do dst; src == dst - w miejscu).
+    inline void ascii_upper(void const* const src, void* const dst, size_t const n) noexcept {
+        detail::dispatch().flip_case(static_cast<u8 const*>(src), static_cast<u8*>(dst), n, 'a');
+    }
+
+    /// Pozycja pierwszej różnicy dwóch ciągów n bajtów bez rozróżniania wielkości liter ASCII
+    /// lub n, jeśli ciągi są równe.
+    inline size_t mismatch_icase(void const* const a, void const* const b, size_t const n) noexcept {
+        return detail::dispatch().mismatch_icase(static_cast<u8 const*>(a), static_cast<u8 const*>(b), n);
+    }
+
+    /// Pozycja pierwszego wystąpienia ciągu needle (m bajtów) lub n, jeśli go nie ma.
+    /// Kandydaci wyznaczani są maskami pierwszego i ostatniego bajtu ciągu,
+    /// porównanie całego ciągu (memcmp) wykonywane jest tylko dla nich.
+    inline size_t find_substr(void const* const data, size_t const n, void const* const needle, size_t const m) noexcept {
+        auto const p = static_cast<u8 const*>(data);
+        auto const q = static_cast<u8 const*>(needle);
+        if (m == 0)
+            return 0;
+        if (m > n)
+            return n;
+        if (m == 1)
+            return find_byte(p, n, static_cast<char>(q[0]));
+
+        auto const mask = detail::dispatch().mask64;
+        auto const last = n - m;
+        size_t i = 0;
+        for (; i + CHUNK <= last + 1; i += CHUNK) {
+            for (auto k = mask(p + i, q[0]) & mask(p + i + m - 1, q[m - 1]); k; k &= k - 1) {
+                auto const pos = i + static_cast<size_t>(std::countr_zero(k));
+                if (std::memcmp(p + pos + 1, q + 1, m - 2) == 0)
+                    return pos;
+            }
+        }
+        for (; i <= last; ++i)
+            if (p[i] == q[0] && std::memcmp(p + i + 1, q + 1, m - 1) == 0)
+                return i;
+        return n;
+    }
+
+    /// Jak find_substr, ale bez rozróżniania wielkości liter ASCII.
+    /// Maski pierwszego i ostatniego bajtu ciągu obejmują obie wielkości litery.
+    inline size_t find_substr_icase(void const* const data, size_t const n, void const* const needle, size_t const m) noexcept {
+        auto const p = static_cast<u8 const*>(data);
+        auto const q = static_cast<u8 const*>(needle);
+        if (m == 0)
+            return 0;
+        if (m > n)
+            return n;
+
+        auto const& k = detail::dispatch();
+        auto const candidates = [&k](u8 const* const s, u8 const c) {
+            auto const lower = fold_ascii(c);
+            auto const upper = static_cast<u8>(lower - 'a') < 26 ? static_cast<u8>(lower ^ 0x20) : lower;
+            auto const mask = k.mask64(s, lower);
+            return lower == upper ? mask : mask | k.mask64(s, upper);
+        };
+
+        auto const last = n - m;
+        size_t i = 0;
+        for (; i + CHUNK <= last + 1; i += CHUNK) {
+            for (auto c = candidates(p + i, q[0]) & candidates(p + i + m - 1, q[m - 1]); c; c &= c - 1) {
+                auto const pos = i + static_cast<size_t>(std::countr_zero(c));
+                if (k.mismatch_icase(p + pos, q, m) == m)
+                    return pos;
+            }
+        }
+        for (auto const first = fold_ascii(q[0]); i <= last; ++i)
+            if (fold_ascii(p[i]) == first && k.mismatch_icase(p + i, q, m) == m)
+                return i;
+        return n;
+    }
+
+    /// Pozycja pierwszego bajtu należącego do zbioru lub n, jeśli takiego nie ma.
+    inline size_t find_any(void const* const data, size_t const n, byte_set const& set) noexcept {
+        auto const p = static_cast<u8 const*>(data);
+        auto const mask = detail::dispatch().mask64_any;
+        size_t i = 0;
+        for (; i + CHUNK <= n; i += CHUNK)
+            if (auto const m = mask(p + i, set))
+                return i + static_cast<size_t>(std::countr_zero(m));
+        for (; i < n; ++i)
+            if (set.contains(static_cast<char>(p[i])))
+                return i;
+        return n;
+    }
+
+    /// Liczba białych znaków na początku ciągu n bajtów.
+    /// Krótkie ciągi białych znaków (typowe) sprawdzane są bajt po bajcie w tablicy,
+    /// dłuższe - maskami dla 64-bajtowych porcji.
+    inline size_t leading_space(void const* const data, size_t const n) noexcept {
+        auto const p = static_cast<u8 const*>(data);
+        size_t i = 0;
+        for (auto const limit = std::min(n, CHUNK); i < limit; ++i)
+            if (!is_space(static_cast<char>(p[i])))
+                return i;
+        if (i == n)
+            return n;
+
+        auto const mask = detail::dispatch().mask64_any;
+        for (; i + CHUNK <= n; i += CHUNK)
+            if (auto const m = ~mask(p + i, SPACE))
+                return i + static_cast<size_t>(std::countr_zero(m));
+        while (i < n && is_space(static_cast<char>(p[i])))
+            ++i;
+        return i;
+    }
+
+    /// Liczba białych znaków na końcu ciągu n bajtów.
+    inline size_t trailing_space(void const* const data, size_t const n) noexcept {
+        auto const p = static_cast<u8 const*>(data);
+        size_t i = n;
+        for (auto const limit = n - std::min(n, CHUNK); i > limit; --i)
+            if (!is_space(static_cast<char>(p[i - 1])))
+                return n - i;
+        if (i == 0)
+            return n;
+
+        auto const mask = detail::dispatch().mask64_any;
+        for (; i >= CHUNK; i -= CHUNK)
+            if (auto const m = ~mask(p + i - CHUNK, SPACE))
+                return n - i + static_cast<size_t>(std::countl_zero(m));
+        while (i > 0 && is_space(static_cast<char>(p[i - 1])))
+            --i;
+        return n - i;
+    }
+
+    /// Czy 8 bajtów od p to cyfry dziesiętne (SWAR - jedno słowo 64-bitowe zamiast 8 porównań).
+    inline bool eight_digits(void const* const p) noexcept {
+        auto const v = load_le64(p);
+        return ((v & 0xf0f0'f0f0'f0f0'f0f0) | (((v + 0x0606'0606'0606'0606) & 0xf0f0'f0f0'f0f0'f0f0) >> 4))
+            == 0x3333'3333'3333'3333;
+    }
+
+    /// Wartość 8 cyfr dziesiętnych od p (wymaga eight_digits(p)).
+    /// Cyfry łączone są parami, czwórkami i ósemkami - trzy mnożenia zamiast ośmiu.
+    inline u32 parse_eight_digits(void const* const p) noexcept {
+        auto v = load_le64(p) - 0x3030'3030'3030'3030;
+        v = v * 10 + (v >> 8);
+        v = ((v & 0x0000'00ff'0000'00ff) * (100 + (u64{1'000'000} << 32))
+           + ((v >> 16) & 0x0000'00ff'0000'00ff) * (1 + (u64{10'000} << 32))) >> 32;
+        return static_cast<u32>(v);
+    }
+
+    /// Wywołanie fn(pos) dla każdej pozycji bajtu należącego do zbioru, w kolejności rosnącej.
+    template<typename Fn>
+    void for_each_any(void const* const data, size_t const n, byte_set const& set, Fn&& fn) {
+        auto const p = static_cast<u8 const*>(data);
+        auto const mask = detail::dispatch().mask64_any;
+        size_t i = 0;
+        for (; i + CHUNK <= n; i += CHUNK)
+            for (auto m = mask(p + i, set); m; m &= m - 1)
+                fn(i + static_cast<size_t>(std::countr_zero(m)));
+        for (; i < n; ++i)
+            if (set.contains(static_cast<char>(p[i])))
+                fn(i);
+    }
+
+    /// Wywołanie fn(pos) dla każdej pozycji bajtu c, w kolejności rosnącej.
+    /// Pełne porcje przetwarzane są maskami - pozycje wyjmowane są z maski bit po bicie.
+    template<typename Fn>
+    void for_each_byte(void const* const data, size_t const n, char const c, Fn&& fn) {
+        auto const p = static_cast<u8 const*>(data);
+        auto const mask = detail::dispatch().mask64;
+        size_t i = 0;
+        for (; i + CHUNK <= n; i += CHUNK)
+            for (auto m = mask(p + i, static_cast<u8>(c)); m; m &= m - 1)
+                fn(i + static_cast<size_t>(std::countr_zero(m)));
+        for (; i < n; ++i)
+            if (p[i] == static_cast<u8>(c))
+                fn(i);
+    }
+}
@@ -0,0 +1,115 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "../crypto/arena/arena.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+    bool all_zero(void const* const ptr, size_t const nbytes) {
+        auto const bytes = static_cast<bee::u8 const*>(ptr);
+        return std::all_of(bytes, bytes + nbytes, [](bee::u8 const b) { return b == 0; });
+    }
+}
+
+TEST(Arena, small_blocks_are_zeroed_and_reused) {
+    using namespace bee::crypto;
+    auto& a = arena::instance();
+
+    for (size_t const n : {1, 15, 16, 17, 64, 100, 4096, 16 * 1024}) {
+        auto const ptr = a.allocate(n);
+        ASSERT_NE(ptr, nullptr) << "n = " << n;
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % std::min<size_t>(std::bit_ceil(n), 64), 0) << "n = " << n;
+        std::memset(ptr, 0xa5, n);
+        a.deallocate(ptr, n);
+
+        // Zwolniony blok wraca z listy wolnych bloków swojej klasy - wyzerowany.
+        auto const again = a.allocate(n);
+        EXPECT_EQ(again, ptr) << "n = " << n;
+        EXPECT_TRUE(all_zero(again, n)) << "n = " << n;
+        a.deallocate(again, n);
+    }
+}
+
+TEST(Arena, large_blocks_are_zeroed_and_reused) {
+    using namespace bee::crypto;
+    auto& a = arena::instance();
+
+    for (size_t const n : {20'000, 100'000, 1024 * 1024}) {
+        auto const ptr = a.allocate(n);
+        ASSERT_NE(ptr, nullptr) << "n = " << n;
+        std::memset(ptr, 0xa5, n);
+        a.deallocate(ptr, n);
+
+        // Blok tej samej klasy (potęga dwójki) jest brany z pamięci podręcznej, bez mmap.
+        auto const again = a.allocate(n - 1);
+        EXPECT_EQ(again, ptr) << "n = " << n;
+        EXPECT_TRUE(all_zero(again, n - 1)) << "n = " << n;
+        a.deallocate(again, n - 1);
+    }
+
+    // Więcej zwolnionych bloków niż mieści pamięć podręczna - nadmiar wraca do systemu.
+    constexpr size_t SIZE = 4 * 1024 * 1024;
+    std::vector<void*> blocks;
+    for (int i = 0; i < 12; ++i) {
+        auto const ptr = a.allocate(SIZE);
+        ASSERT_NE(ptr, nullptr);
+        std::memset(ptr, i + 1, SIZE);
+        blocks.push_back(ptr);
+    }
+    for (auto const ptr : blocks)
+        a.deallocate(ptr, SIZE);
+    for (auto& ptr : blocks) {
+        ptr = a.allocate(SIZE);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_TRUE(all_zero(ptr, SIZE));
+    }
+    for (auto const ptr : blocks)
+        a.deallocate(ptr, SIZE);
+}
+
+TEST(Arena, concurrent_use) {
+    using namespace bee::crypto;
+    auto& a = arena::instance();
+
+    // Przydziały z wielu wątków (małe i duże bloki) oraz odczyt locked() w trakcie mapowania stron.
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&a, t] {
+            for (int i = 0; i < 200; ++i) {
+                auto const n = i % 10 == 0 ? size_t{64 * 1024} * (1 + i % 3) : size_t(16 + (i * 37 + t) % 2000);
+                auto const ptr = static_cast<bee::u8*>(a.allocate(n));
+                ASSERT_NE(ptr, nullptr);
+                ASSERT_TRUE(all_zero(ptr, n));
+                std::memset(ptr, t + 1, n);
+                ASSERT_EQ(ptr[n - 1], t + 1);
+                [[maybe_unused]] auto const locked = a.locked();
+                a.deallocate(ptr, n);
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+}
+
+TEST(Arena, secure_containers) {
+    using namespace bee::crypto;
+
+    secure_bytes bytes(100'000, 0x5a);
+    bytes.resize(200'000, 0x5b);
+    EXPECT_EQ(bytes[99'999], 0x5a);
+    EXPECT_EQ(bytes[100'000], 0x5b);
+
+    struct key {
+        bee::u32 words[8];
+    };
+    auto const ptr = make_secure<key>();
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_TRUE(all_zero(ptr->words, sizeof(ptr->words)));
+}
@@ -0,0 +1,360 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "../crypto/blowfish/blowfish.h"
+#include "../crypto/blowfish/multi_buffer.h"
+#include <algorithm>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    using bytes = std::vector<bee::u8>;
+
+    std::string hex(bee::u8 const* const data, size_t const nbytes) {
+        constexpr char digits[] = "0123456789abcdef";
+        std::string out;
+        for (size_t i = 0; i < nbytes; ++i) {
+            out += digits[data[i] >> 4];
+            out += digits[data[i] & 15];
+        }
+        return out;
+    }
+
+    // Powtarzalne dane testowe (bez zależności od generatora losowego).
+    bytes pattern(size_t const n, bee::u32 x = 0x12345678) {
+        bytes data(n);
+        for (auto& b : data) {
+            x = x * 1664525 + 1013904223;
+            b = static_cast<bee::u8>(x >> 24);
+        }
+        return data;
+    }
+
+    // Podział bufora na fragmenty o nieregularnych rozmiarach (także puste),
+    // tak aby bloki szyfru przekraczały granice fragmentów.
+    template<typename T>
+    std::vector<std::span<T>> split(std::span<T> const data) {
+        constexpr size_t sizes[] = {3, 0, 5, 1, 11, 8, 2};
+        std::vector<std::span<T>> parts;
+        for (size_t pos = 0, i = 0; pos < data.size(); ++i) {
+            auto const n = std::min(sizes[i % std::size(sizes)], data.size() - pos);
+            parts.push_back(data.subspan(pos, n));
+            pos += n;
+        }
+        return parts;
+    }
+
+    bee::crypto::blowfish make_cipher(std::string_view const key = "bee toolbox key") {
+        return bee::crypto::blowfish{key.data(), key.size()};
+    }
+}
+
+TEST(Blowfish, schedule_round_trip) {
+    using namespace bee;
+
+    auto const bf = make_cipher();
+    auto const blob = bf.export_schedule();
+    ASSERT_EQ(blob.size(), crypto::blowfish::schedule_size());
+
+    auto const restored = crypto::blowfish::from_schedule(blob.data(), blob.size());
+    ASSERT_TRUE(restored.has_value());
+    auto const data = pattern(100);
+    EXPECT_EQ(restored->encrypt_ecb(data.data(), data.size()), bf.encrypt_ecb(data.data(), data.size()));
+    EXPECT_EQ(restored->decrypt_ecb(bf.encrypt_ecb(data.data(), data.size())), data);
+
+    // Ponowny eksport daje ten sam blob.
+    auto const again = restored->export_schedule();
+    EXPECT_TRUE(std::ranges::equal(again, blob));
+}
+
+TEST(Blowfish, schedule_rejects_corrupted_blob) {
+    using namespace bee;
+
+    auto const blob = make_cipher().export_schedule();
+    auto const size = blob.size();
+    auto const tag_at = size - sizeof(u64);
+
+    // FNV-1a jak w blowfish.cpp - pozwala zbudować blob z poprawnym tagiem, ale złą wersją.
+    auto const retag = [&](bytes& b) {
+        u64 h = 0xcbf29ce484222325;
+        for (size_t i = 0; i < tag_at; ++i) {
+            h ^= b[i];
+            h *= 0x100000001b3;
+        }
+        for (size_t i = 0; i < sizeof(u64); ++i)
+            b[tag_at + i] = static_cast<u8>(h >> (8 * i));
+    };
+
+    bytes const good(blob.begin(), blob.end());
+    EXPECT_TRUE(crypto::blowfish::from_schedule(good.data(), good.size()).has_value());
+
+    // Uszkodzone tablice, tag, magic.
+    for (size_t const at : {size_t{0}, size_t{8}, size_t{100}, tag_at - 1, tag_at, size - 1}) {
+        auto bad = good;
+        bad[at] ^= 0x01;
+        EXPECT_FALSE(crypto::blowfish::from_schedule(bad.data(), bad.size()).has_value()) << "at = " << at;
+    }
+
+    // Nieznana wersja, nawet z poprawnym tagiem.
+    auto version = good;
+    version[4] = 2;
+    retag(version);
+    EXPECT_FALSE(crypto::blowfish::from_schedule(version.data(), version.size()).has_value());
+    auto same = good;
+    retag(same);
+    EXPECT_EQ(same, good);
+
+    // Zły rozmiar.
+    EXPECT_FALSE(crypto::blowfish::from_schedule(good.data(), size - 1).has_value());
+    auto longer = good;
+    longer.push_back(0);
+    EXPECT_FALSE(crypto::blowfish::from_schedule(longer.data(), longer.size()).has_value());
+    EXPECT_FALSE(crypto::blowfish::from_schedule(nullptr, size).has_value());
+}
+
+TEST(Blowfish, cbc_batch_matches_encrypt_cbc) {
+    using namespace bee;
+
+    auto const bf = make_cipher();
+
+    // Wiadomości o różnych długościach (także puste), aby tory kończyły pracę w różnych momentach.
+    std::vector<bytes> messages;
+    for (size_t n = 0; n <= 40; ++n)
+        messages.push_back(pattern(n, static_cast<u32>(n)));
+    messages.push_back(pattern(1000));
+    messages.push_back({});
+    messages.push_back(pattern(3));
+
+    auto const result = bf.encrypt_cbc_batch(messages);
+    ASSERT_EQ(result.size(), messages.size());
+    for (size_t i = 0; i < messages.size(); ++i) {
+        auto const& msg = messages[i];
+        auto const cipher = result[i];
+        if (msg.empty()) {
+            EXPECT_TRUE(cipher.empty()) << "i = " << i;
+            continue;
+        }
+        // Ten sam szyfrogram co encrypt_cbc z IV wylosowanym dla tej wiadomości.
+        ASSERT_GE(cipher.size(), 8) << "i = " << i;
+        auto const expected = bf.encrypt_cbc(msg.data(), msg.size(), cipher.data());
+        EXPECT_TRUE(std::ranges::equal(cipher, expected)) << "i = " << i;
+        EXPECT_EQ(bf.decrypt_cbc(cipher.data(), cipher.size()), msg) << "i = " << i;
+    }
+
+    // Każda wiadomość ma własny IV.
+    EXPECT_FALSE(std::ranges::equal(result[1].first(8), result[2].first(8)));
+
+    // Wiadomości jako tekst.
+    std::vector<std::string> const texts{"ala ma kota", "", "x", std::string(100, 'q')};
+    auto const text_result = bf.encrypt_cbc_batch(texts);
+    ASSERT_EQ(text_result.size(), texts.size());
+    for (size_t i = 0; i < texts.size(); ++i) {
+        auto const cipher = text_result[i];
+        auto const plain = bf.decrypt_cbc(cipher.data(), cipher.size());
+        EXPECT_EQ(std::string(plain.begin(), plain.end()), texts[i]) << "i = " << i;
+    }
+    EXPECT_EQ(bf.encrypt_cbc_batch(std::vector<bytes>{}).size(), 0);
+    auto const empty = bf.encrypt_cbc_batch(std::vector<bytes>(3));
+    ASSERT_EQ(empty.size(), 3);
+    EXPECT_TRUE(empty[0].empty() && empty[2].empty());
+}
+
+TEST(Blowfish, fragments_match_contiguous) {
+    using namespace bee;
+
+    auto const bf = make_cipher();
+    u8 const iv[8]{1, 2, 3, 4, 5, 6, 7, 8};
+
+    for (size_t const n : {1, 3, 7, 8, 9, 16, 17, 63, 64, 65, 100}) {
+        auto const plain = pattern(n);
+        auto const in = split(std::span<u8 const>{plain});
+
+        auto const ecb = bf.encrypt_ecb(plain.data(), n);
+        bytes out(ecb.size());
+        auto const out_parts = split(std::span<u8>{out});
+        ASSERT_EQ(bf.encrypt_ecb(in, out_parts), ecb.size()) << "n = " << n;
+        EXPECT_EQ(out, ecb) << "n = " << n;
+
+        auto const cbc = bf.encrypt_cbc(plain.data(), n, iv);
+        bytes out_cbc(cbc.size());
+        auto const out_cbc_parts = split(std::span<u8>{out_cbc});
+        ASSERT_EQ(bf.encrypt_cbc(in, out_cbc_parts, iv), cbc.size()) << "n = " << n;
+        EXPECT_EQ(out_cbc, cbc) << "n = " << n;
+
+        // Odszyfrowanie z fragmentów do fragmentów.
+        bytes back(ecb.size());
+        auto const back_parts = split(std::span<u8>{back});
+        ASSERT_EQ(bf.decrypt_ecb(split(std::span<u8 const>{ecb}), back_parts), n) << "n = " << n;
+        EXPECT_TRUE(std::equal(plain.begin(), plain.end(), back.begin())) << "n = " << n;
+
+        std::ranges::fill(back, 0);
+        ASSERT_EQ(bf.decrypt_cbc(split(std::span<u8 const>{cbc}), back_parts), n) << "n = " << n;
+        EXPECT_TRUE(std::equal(plain.begin(), plain.end(), back.begin())) << "n = " << n;
+
+        // Za mało miejsca w 'out' - nic nie jest zapisywane.
+        bytes small(ecb.size() - 1, 0xee);
+        std::span<u8> const small_part{small};
+        EXPECT_EQ(bf.encrypt_ecb(in, {&small_part, 1}), 0) << "n = " << n;
+        bytes small_cbc(cbc.size() - 9, 0xee);
+        std::span<u8> const small_cbc_part{small_cbc};
+        EXPECT_EQ(bf.decrypt_cbc(split(std::span<u8 const>{cbc}), {&small_cbc_part, 1}), 0) << "n = " << n;
+        EXPECT_TRUE(std::ranges::all_of(small_cbc, [](u8 const b) { return b == 0xee; })) << "n = " << n;
+    }
+
+    // Szyfrogram, którego rozmiar nie jest wielokrotnością bloku.
+    bytes junk(13);
+    std::span<u8 const> const junk_part{junk};
+    bytes out(16);
+    std::span<u8> const out_part{out};
+    EXPECT_EQ(bf.decrypt_ecb({&junk_part, 1}, {&out_part, 1}), 0);
+}
+
+TEST(Blowfish, multi_buffer_matches_single_key) {
+    using namespace bee;
+    using crypto::multi_buffer;
+
+    crypto::blowfish const ciphers[] = {make_cipher("first key"), make_cipher("second key"), make_cipher("third key")};
+    u8 const iv[8]{0xa0, 0xb1, 0xc2, 0xd3, 0xe4, 0xf5, 0x06, 0x17};
+
+    // Więcej zadań niż torów, o różnych długościach - tory kończą pracę w różnych momentach.
+    constexpr size_t JOBS = 3 * multi_buffer::LANES + 1;
+    std::vector<bytes> plain, out(JOBS);
+    std::vector<multi_buffer::job> jobs;
+    for (size_t i = 0; i < JOBS; ++i) {
+        plain.push_back(pattern((i * 7 % 13) * 8 + (i == 5 ? 800 : 0), static_cast<u32>(i)));
+        out[i].resize(plain[i].size());
+        jobs.push_back({&ciphers[i % 3], plain[i].data(), out[i].data(), plain[i].size(), i % 2 ? iv : nullptr});
+    }
+    ASSERT_TRUE(multi_buffer::encrypt(jobs));
+
+    for (size_t i = 0; i < JOBS; ++i) {
+        auto const& bf = ciphers[i % 3];
+        auto const n = plain[i].size();
+        if (n == 0)
+            continue;
+        // ECB: każdy blok jak encrypt_block; CBC: jak encrypt_cbc bez początkowego IV.
+        bytes expected(n);
+        if (i % 2) {
+            auto const cbc = bf.encrypt_cbc(plain[i].data(), n, iv);
+            expected.assign(cbc.begin() + 8, cbc.end());
+        } else {
+            for (size_t pos = 0; pos < n; pos += 8) {
+                u32 words[2];
+                load_le32(plain[i].data() + pos, words);
+                bf.encrypt_block(words, words);
+                store_le32(expected.data() + pos, words);
+            }
+        }
+        EXPECT_EQ(out[i], expected) << "job = " << i;
+    }
+
+    // Odszyfrowanie w miejscu przywraca dane.
+    for (size_t i = 0; i < JOBS; ++i)
+        jobs[i].src = out[i].data();
+    ASSERT_TRUE(multi_buffer::decrypt(jobs));
+    EXPECT_EQ(out, plain);
+
+    // Niepoprawne zadanie - nic nie jest przetwarzane.
+    auto const before = out;
+    jobs[1].nbytes -= 1;
+    EXPECT_FALSE(multi_buffer::encrypt(jobs));
+    jobs[1].nbytes += 1;
+    jobs[2].cipher = nullptr;
+    EXPECT_FALSE(multi_buffer::decrypt(jobs));
+    EXPECT_EQ(out, before);
+    EXPECT_TRUE(multi_buffer::encrypt({}));
+}
+
+TEST(Blowfish, known_answer) {
+    using namespace bee;
+
+    // Wektory testowe Blowfish (Eric Young); słowa bloku jak w zapisie big-endian wektorów.
+    struct Test {
+        std::string key;
+        u32 plain[2];
+        u32 expected[2];
+    } tests[] = {
+                {std::string(8, '\0'), {0x00000000, 0x00000000}, {0x4ef99745, 0x6198dd78}},
+                {std::string(8, '\xff'), {0xffffffff, 0xffffffff}, {0x51866fd5, 0xb85ecb8a}},
+                {std::string("\x30\0\0\0\0\0\0\0", 8), {0x10000000, 0x00000001}, {0x7d856f9a, 0x613063f2}},
+                {"\x01\x23\x45\x67\x89\xab\xcd\xef", {0x11111111, 0x11111111}, {0x61f9c380, 0x2281b096}},
+            };
+
+    for (auto&& [key, plain, expected]: tests) {
+        crypto::blowfish const bf{key.data(), key.size()};
+        u32 cipher[2], back[2];
+        bf.encrypt_block(plain, cipher);
+        EXPECT_EQ(cipher[0], expected[0]);
+        EXPECT_EQ(cipher[1], expected[1]);
+        bf.decrypt_block(cipher, back);
+        EXPECT_EQ(back[0], plain[0]);
+        EXPECT_EQ(back[1], plain[1]);
+    }
+}
+
+TEST(Blowfish, output_matches_baseline) {
+    using namespace bee;
+
+    // Szyfrogramy sprzed przejścia na load_le32/store_le32 - format danych nie może się zmienić.
+    auto const bf = make_cipher();
+    u8 const iv[8]{0, 1, 2, 3, 4, 5, 6, 7};
+    struct Test {
+        size_t size;
+        std::string ecb;
+        std::string cbc;
+    } tests[] = {
+                {1, "1a59a220d5690ee4", "00010203040506079425d8dee573f6ca"},
+                {7, "1629d6e9bdbb3a7a", "0001020304050607a42653329a2a5cfd"},
+                {8, "478db6e19ad6a288", "0001020304050607cd8e9a95266a302d"},
+                {9, "478db6e19ad6a2887ddc911f08792d44", "0001020304050607cd8e9a95266a302dbe4349528cb38699"},
+                {16, "478db6e19ad6a28822b2d7696a2228c2", "0001020304050607cd8e9a95266a302dfcfcfc3dcc033a4c"},
+                {23, "478db6e19ad6a28822b2d7696a2228c213aa3d77e9a05fe3",
+                    "0001020304050607cd8e9a95266a302dfcfcfc3dcc033a4c087f1124ed22f242"},
+            };
+
+    bytes data(23);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<u8>(i * 37 + 11);
+
+    for (auto&& [size, ecb, cbc]: tests) {
+        auto const ecb_out = bf.encrypt_ecb(data.data(), size);
+        auto const cbc_out = bf.encrypt_cbc(data.data(), size, iv);
+        EXPECT_EQ(hex(ecb_out.data(), ecb_out.size()), ecb) << "size = " << size;
+        EXPECT_EQ(hex(cbc_out.data(), cbc_out.size()), cbc) << "size = " << size;
+        EXPECT_EQ(bf.decrypt_ecb(ecb_out.data(), ecb_out.size()), bytes(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(size)));
+        EXPECT_EQ(bf.decrypt_cbc(cbc_out.data(), cbc_out.size()), bytes(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(size)));
+    }
+
+    auto const ofb = bf.encrypt_ofb(data.data(), data.size(), iv);
+    auto const cfb = bf.encrypt_cfb(data.data(), data.size(), iv);
+    EXPECT_EQ(hex(ofb.data(), ofb.size()), "0001020304050607188e167ac86346f2e1842d79910e80ca7f2dd142aefe04");
+    EXPECT_EQ(hex(cfb.data(), cfb.size()), "0001020304050607188e167ac86346f25b3f717414d331a4365a6d45b28408");
+}
+
+TEST(Blowfish, load_store_unaligned) {
+    using namespace bee;
+
+    // Odczyt i zapis słów pod każdym przesunięciem względem wyrównania.
+    alignas(8) u8 buffer[24]{};
+    for (size_t offset = 0; offset < 8; ++offset) {
+        u32 const words[2]{0x04030201, 0x08070605};
+        store_le32(buffer + offset, words);
+        for (u8 i = 0; i < 8; ++i)
+            EXPECT_EQ(buffer[offset + i], i + 1) << "offset = " << offset;
+        EXPECT_EQ(load_le32(buffer + offset + 4), 0x08070605u);
+        EXPECT_EQ(load_be32(buffer + offset), 0x01020304u);
+
+        u32 back[2];
+        load_le32(buffer + offset, back);
+        EXPECT_EQ(back[0], words[0]);
+        EXPECT_EQ(back[1], words[1]);
+        store_be32(buffer + offset, words);
+        EXPECT_EQ(buffer[offset], 0x04);
+        EXPECT_EQ(buffer[offset + 7], 0x05);
+    }
+}
@@ -0,0 +1,209 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "../toolbox.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    // Długości wokół szerokości wektorów (16/32/64 bajty), aby działały też ścieżki końcówek.
+    std::vector<size_t> lengths() {
+        std::vector<size_t> out{0, 1, 2, 3, 7, 8, 9};
+        for (size_t const width : {16, 32, 64, 128})
+            for (size_t const n : {width - 1, width, width + 1})
+                out.push_back(n);
+        out.push_back(200);
+        return out;
+    }
+
+    // Tekst z liter obu wielkości, znaków granicznych ('@', '[', '`', '{') i bajtów spoza ASCII.
+    std::string mixed(size_t const n, size_t const seed = 0) {
+        constexpr std::string_view alphabet{"aZ@[`{mQ0 \xc0\xe0\xff\x80zA~\x7f"};
+        std::string out;
+        for (size_t i = 0; i < n; ++i)
+            out += alphabet[(i * 7 + seed) % alphabet.size()];
+        return out;
+    }
+
+    char lower(char const c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c + 32) : c; }
+    char upper(char const c) { return c >= 'a' && c <= 'z' ? static_cast<char>(c - 32) : c; }
+
+    std::string scalar(std::string_view const sv, char (*fn)(char)) {
+        std::string out;
+        for (auto const c : sv)
+            out += fn(c);
+        return out;
+    }
+}
+
+TEST(Case, to_lower_to_upper) {
+    using namespace bee;
+
+    for (auto const n : lengths()) {
+        // Przesunięcie początku - dane niewyrównane do szerokości wektora.
+        for (size_t const offset : {0, 1, 3}) {
+            auto const source = mixed(n + offset, n);
+            auto const text = std::string_view{source}.substr(offset);
+            auto const expected_lower = scalar(text, lower);
+            auto const expected_upper = scalar(text, upper);
+
+            EXPECT_EQ(box::to_lower(text), expected_lower) << "n = " << n;
+            EXPECT_EQ(box::to_upper(text), expected_upper) << "n = " << n;
+
+            std::string in_place{text};
+            box::lower_in_place(in_place);
+            EXPECT_EQ(in_place, expected_lower) << "n = " << n;
+            box::upper_in_place(in_place);
+            EXPECT_EQ(in_place, expected_upper) << "n = " << n;
+
+            // Bufor docelowy ze strażnikami - nic poza wynikiem nie może zostać zapisane.
+            std::string buffer(n + 2, '#');
+            auto const out = box::to_lower(text, std::span<char>{buffer.data() + 1, n});
+            EXPECT_EQ(std::string_view(out.data(), out.size()), expected_lower);
+            EXPECT_EQ(buffer.front(), '#');
+            EXPECT_EQ(buffer.back(), '#');
+        }
+    }
+}
+
+TEST(Case, to_lower_span_shorter_than_text) {
+    using namespace bee;
+
+    char buffer[4];
+    auto const out = box::to_upper("abcdefgh", buffer);
+    EXPECT_EQ(std::string_view(out.data(), out.size()), "ABCD");
+}
+
+TEST(Case, utf8) {
+    using namespace bee;
+
+    struct Test {
+        std::string input;
+        std::string lower;
+        std::string upper;
+    } tests[] = {
+                {"", "", ""},
+                {"Zażółć Gęślą Jaźń", "zażółć gęślą jaźń", "ZAŻÓŁĆ GĘŚLĄ JAŹŃ"},
+                {"ÀÉÎÕÜ àéîõü", "àéîõü àéîõü", "ÀÉÎÕÜ ÀÉÎÕÜ"},
+                {"Αλφα ΒΗΤΑ", "αλφα βητα", "ΑΛΦΑ ΒΗΤΑ"},
+                {"Привет МИР", "привет мир", "ПРИВЕТ МИР"},
+                // Znaki spoza obsługiwanych zakresów (3 bajty) i niepoprawne sekwencje bez zmian.
+                {"Cena 5€ OK", "cena 5€ ok", "CENA 5€ OK"},
+                {"A\xff" "b\xc3", "a\xff" "b\xc3", "A\xff" "B\xc3"},
+                {"\xc3" "A", "\xc3" "a", "\xc3" "A"},
+            };
+
+    for (auto&& [input, lower, upper]: tests) {
+        EXPECT_EQ(box::utf8_to_lower(input), lower) << input;
+        EXPECT_EQ(box::utf8_to_upper(input), upper) << input;
+    }
+
+    // Długie ciągi ASCII (ścieżka wektorowa) przeplatane znakami wielobajtowymi.
+    for (auto const n : lengths()) {
+        std::string const ascii(n, 'Q');
+        auto const input = ascii + "Ł" + ascii + "Ж";
+        EXPECT_EQ(box::utf8_to_lower(input), std::string(n, 'q') + "ł" + std::string(n, 'q') + "ж") << "n = " << n;
+    }
+}
+
+TEST(Case, iequals_icompare) {
+    using namespace bee;
+
+    for (auto const n : lengths()) {
+        auto const a = mixed(n, 5);
+        auto const b = scalar(a, upper);
+        EXPECT_TRUE(box::iequals(a, b)) << "n = " << n;
+        EXPECT_EQ(box::icompare(a, b), 0) << "n = " << n;
+        if (!n)
+            continue;
+
+        // Różnica na ostatniej pozycji - wynik zależy od ścieżki końcówki.
+        auto c = b;
+        c.back() = 'z' == lower(c.back()) ? 'a' : 'z';
+        // Porządek bajtów bez znaku - jak w std::string_view::compare.
+        auto const sign = static_cast<u8>(lower(a.back())) < static_cast<u8>(lower(c.back())) ? -1 : 1;
+        EXPECT_FALSE(box::iequals(a, c)) << "n = " << n;
+        EXPECT_EQ(box::icompare(a, c), sign) << "n = " << n;
+        EXPECT_EQ(box::icompare(c, a), -sign) << "n = " << n;
+
+        // Krótszy tekst będący prefiksem jest mniejszy.
+        EXPECT_EQ(box::icompare(std::string_view{a}.substr(0, n - 1), b), -1) << "n = " << n;
+        EXPECT_EQ(box::icompare(a, std::string_view{b}.substr(0, n - 1)), 1) << "n = " << n;
+        EXPECT_FALSE(box::iequals(std::string_view{a}.substr(0, n - 1), b)) << "n = " << n;
+    }
+
+    // Znaki różniące się bitem 0x20, które nie są literami, pozostają różne.
+    std::pair<char, char> const pairs[] = {{'@', '`'}, {'[', '{'}, {'^', '~'}, {'\xc0', '\xe0'}, {'\xd3', '\xf3'}};
+    for (auto const n : lengths()) {
+        if (!n)
+            continue;
+        for (auto const& [x, y] : pairs) {
+            std::string a(n, 'k');
+            std::string b(n, 'K');
+            a.back() = x;
+            b.back() = y;
+            EXPECT_FALSE(box::iequals(a, b)) << "n = " << n << ", " << x;
+            EXPECT_NE(box::icompare(a, b), 0) << "n = " << n << ", " << x;
+        }
+    }
+}
+
+TEST(Case, istarts_with_iends_with) {
+    using namespace bee;
+
+    for (auto const n : lengths()) {
+        auto const text = mixed(n + 3, 2);
+        auto const shouted = scalar(text, upper);
+        auto const prefix = std::string_view{shouted}.substr(0, n);
+        auto const suffix = std::string_view{shouted}.substr(3);
+        EXPECT_TRUE(box::istarts_with(text, prefix)) << "n = " << n;
+        EXPECT_TRUE(box::iends_with(text, suffix)) << "n = " << n;
+        EXPECT_FALSE(box::istarts_with(prefix, text)) << "n = " << n;
+        EXPECT_FALSE(box::iends_with(suffix, text)) << "n = " << n;
+    }
+
+    EXPECT_TRUE(box::istarts_with("Content-Type: text", "content-type"));
+    EXPECT_FALSE(box::istarts_with("Content-Typ", "content-type"));
+    EXPECT_TRUE(box::iends_with("archive.TAR.GZ", ".tar.gz"));
+    EXPECT_FALSE(box::iends_with("archive.tar.gz@", ".tar.gz`"));
+    EXPECT_TRUE(box::istarts_with("abc", ""));
+    EXPECT_TRUE(box::iends_with("", ""));
+}
+
+TEST(Case, ifind) {
+    using namespace bee;
+    constexpr auto npos = std::string_view::npos;
+
+    EXPECT_EQ(box::ifind("Hello World", "WORLD"), 6);
+    EXPECT_EQ(box::ifind("Hello World", "o"), 4);
+    EXPECT_EQ(box::ifind("Hello World", "O", 5), 7);
+    EXPECT_EQ(box::ifind("Hello World", "x"), npos);
+    EXPECT_EQ(box::ifind("Hello World", "world!"), npos);
+    EXPECT_EQ(box::ifind("a@b", "A`"), npos);
+    EXPECT_EQ(box::ifind("", "a"), npos);
+
+    // Pusty wzorzec - jak std::string_view::find.
+    EXPECT_EQ(box::ifind("abc", ""), 0);
+    EXPECT_EQ(box::ifind("abc", "", 2), 2);
+    EXPECT_EQ(box::ifind("abc", "", 3), 3);
+    EXPECT_EQ(box::ifind("abc", "", 4), npos);
+    EXPECT_EQ(box::ifind("abc", "a", 4), npos);
+
+    // Wzorzec na każdej pozycji, także na granicach wektorów i na samym końcu.
+    for (auto const n : lengths()) {
+        for (auto const needle : {"x", "NeEdLe", "ab\xc0Z"}) {
+            auto const size = std::string_view{needle}.size();
+            for (size_t at = 0; at + size <= n; at += at < 3 || at + size + 3 > n ? 1 : 13) {
+                std::string text(n, 'n');
+                text.replace(at, size, scalar(needle, at % 2 ? lower : upper));
+                auto const expected = scalar(text, lower).find(scalar(needle, lower));
+                EXPECT_EQ(box::ifind(text, needle), expected) << "n = " << n << ", at = " << at;
+                EXPECT_EQ(box::ifind(text, needle, at), at) << "n = " << n << ", at = " << at;
+                EXPECT_EQ(box::ifind(text, needle, at + 1), npos) << "n = " << n << ", at = " << at;
+            }
+        }
+    }
+}
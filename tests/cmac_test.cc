@@ -0,0 +1,206 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "../crypto/blowfish/blowfish.h"
+#include "../crypto/cmac/cmac.h"
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    using bytes = std::vector<bee::u8>;
+
+    std::string hex(bee::u8 const* const data, size_t const nbytes) {
+        constexpr char digits[] = "0123456789abcdef";
+        std::string out;
+        for (size_t i = 0; i < nbytes; ++i) {
+            out += digits[data[i] >> 4];
+            out += digits[data[i] & 15];
+        }
+        return out;
+    }
+
+    bytes pattern(size_t const n, bee::u32 x = 0x12345678) {
+        bytes data(n);
+        for (auto& b : data) {
+            x = x * 1664525 + 1013904223;
+            b = static_cast<bee::u8>(x >> 24);
+        }
+        return data;
+    }
+
+    bee::crypto::blowfish make_cipher(std::string_view const key) {
+        return bee::crypto::blowfish{key.data(), key.size()};
+    }
+
+    // CMAC wprost z definicji NIST SP 800-38B (rozdział 6), na tablicach bajtów.
+    struct reference {
+        bee::crypto::blowfish const& cipher;
+
+        void encrypt(bee::u8* const block) const {
+            bee::u32 words[2];
+            bee::load_le32(block, words);
+            cipher.encrypt_block(words, words);
+            bee::store_le32(block, words);
+        }
+
+        // Przesunięcie ciągu bitów w lewo o 1; jeśli najstarszy bit był ustawiony, XOR z R_64.
+        static void dbl(bee::u8 const* const src, bee::u8* const dst) {
+            bool const msb = src[0] & 0x80;
+            for (size_t i = 0; i < 8; ++i)
+                dst[i] = static_cast<bee::u8>(src[i] << 1 | (i + 1 < 8 ? src[i + 1] >> 7 : 0));
+            if (msb)
+                dst[7] ^= 0x1b;
+        }
+
+        bytes tag(bytes const& msg) const {
+            bee::u8 l[8]{}, k1[8], k2[8];
+            encrypt(l);
+            dbl(l, k1);
+            dbl(k1, k2);
+
+            auto const n = msg.empty() ? 1 : (msg.size() + 7) / 8;
+            bool const complete = !msg.empty() && msg.size() % 8 == 0;
+            bee::u8 c[8]{};
+            for (size_t i = 0; i < n; ++i) {
+                bee::u8 m[8]{};
+                auto const size = std::min<size_t>(8, msg.size() - std::min(msg.size(), 8 * i));
+                if (size)
+                    std::memcpy(m, msg.data() + 8 * i, size);
+                if (i + 1 == n) {
+                    if (!complete)
+                        m[size] = 0x80;
+                    for (size_t j = 0; j < 8; ++j)
+                        m[j] ^= complete ? k1[j] : k2[j];
+                }
+                for (size_t j = 0; j < 8; ++j)
+                    c[j] ^= m[j];
+                encrypt(c);
+            }
+            return {c, c + 8};
+        }
+    };
+
+    bytes cmac_tag(bee::crypto::blowfish const& cipher, bee::u8 const* const data, size_t const nbytes) {
+        bee::crypto::cmac mac{cipher};
+        mac.update(data, nbytes);
+        bytes tag(bee::crypto::cmac<bee::crypto::blowfish>::TAG_SIZE);
+        mac.final(tag.data());
+        return tag;
+    }
+}
+
+TEST(Cmac, known_answer) {
+    using namespace bee;
+
+    // Długości wiadomości jak w przykładach SP 800-38B dla 64-bitowego bloku: 0, 64, 160 i 256 bitów.
+    // Oczekiwane tagi policzone niezależną implementacją Blowfish i CMAC (bajty bloku jak w load_le32).
+    auto const bf = make_cipher("cmac test key");
+    auto const msg = pattern(32);
+    struct Test {
+        size_t size;
+        std::string expected;
+    } tests[] = {
+                {0, "dcaaba432bc923eb"},
+                {8, "60d24063a020a6c4"},
+                {20, "b95f47a54835ce69"},
+                {32, "4c83c527ff9c5576"},
+            };
+
+    reference const ref{bf};
+    for (auto&& [size, expected]: tests) {
+        bytes const part(msg.begin(), msg.begin() + static_cast<std::ptrdiff_t>(size));
+        EXPECT_EQ(hex(ref.tag(part).data(), 8), expected) << "size = " << size;
+        EXPECT_EQ(cmac_tag(bf, msg.data(), size), ref.tag(part)) << "size = " << size;
+    }
+}
+
+TEST(Cmac, matches_definition_in_parts) {
+    using namespace bee;
+
+    auto const bf = make_cipher("cmac test key");
+    reference const ref{bf};
+    auto const msg = pattern(100);
+
+    for (size_t n = 0; n <= msg.size(); ++n) {
+        bytes const part(msg.begin(), msg.begin() + static_cast<std::ptrdiff_t>(n));
+        auto const expected = ref.tag(part);
+        ASSERT_EQ(cmac_tag(bf, msg.data(), n), expected) << "n = " << n;
+
+        // Dane w porcjach (także pustych) dają ten sam tag; obiekt po final jest gotowy do ponownego użycia.
+        crypto::cmac mac{bf};
+        for (size_t const step : {1, 3, 8, 13}) {
+            for (size_t pos = 0; pos <= n; pos += step)
+                mac.update(msg.data() + pos, std::min(step, n - pos));
+            bytes tag(8);
+            mac.final(tag.data());
+            ASSERT_EQ(tag, expected) << "n = " << n << ", step = " << step;
+        }
+    }
+}
+
+TEST(Cmac, authenticated_round_trip) {
+    using namespace bee;
+
+    auto const data_key = make_cipher("data key");
+    auto const mac_key = make_cipher("mac key");
+    crypto::authenticated const ae{data_key, mac_key};
+    u8 const iv[8]{9, 8, 7, 6, 5, 4, 3, 2};
+
+    for (size_t const n : {0, 1, 7, 8, 9, 15, 16, 17, 100}) {
+        auto const plain = pattern(n);
+        auto const sealed = ae.encrypt(plain.data(), n, iv);
+        auto const body = sealed.size() - 8;
+        ASSERT_EQ(sealed.size(), 8 + (n / 8 + 1) * 8 + 8) << "n = " << n;
+
+        auto const opened = ae.decrypt(sealed.data(), sealed.size());
+        ASSERT_TRUE(opened.has_value()) << "n = " << n;
+        EXPECT_EQ(*opened, plain) << "n = " << n;
+
+        // Szyfrogram to CBC danych z 'uzupełnieniem' 0x80 00..., a tag to CMAC z IV i szyfrogramu.
+        auto padded = plain;
+        padded.push_back(0x80);
+        padded.resize((n / 8 + 1) * 8, 0);
+        auto const cbc = data_key.encrypt_cbc(padded.data(), padded.size(), iv);
+        EXPECT_TRUE(std::equal(cbc.begin(), cbc.end(), sealed.begin())) << "n = " << n;
+        EXPECT_TRUE(std::ranges::equal(cmac_tag(mac_key, sealed.data(), body), std::span{sealed}.subspan(body))) << "n = " << n;
+    }
+}
+
+TEST(Cmac, authenticated_rejects_tampering) {
+    using namespace bee;
+
+    auto const data_key = make_cipher("data key");
+    auto const mac_key = make_cipher("mac key");
+    crypto::authenticated const ae{data_key, mac_key};
+
+    auto const plain = pattern(21);
+    auto const sealed = ae.encrypt(plain.data(), plain.size());
+
+    // Zmiana dowolnego bitu IV, szyfrogramu lub tagu.
+    for (size_t i = 0; i < sealed.size(); ++i) {
+        for (u8 const bit : {0x01, 0x80}) {
+            auto bad = sealed;
+            bad[i] ^= bit;
+            EXPECT_FALSE(ae.decrypt(bad.data(), bad.size()).has_value()) << "i = " << i;
+        }
+    }
+
+    // Obcięte lub wydłużone dane, zamienione klucze.
+    EXPECT_FALSE(ae.decrypt(sealed.data(), sealed.size() - 1).has_value());
+    EXPECT_FALSE(ae.decrypt(sealed.data(), sealed.size() - 8).has_value());
+    EXPECT_FALSE(ae.decrypt(sealed.data() + 8, sealed.size() - 8).has_value());
+    auto longer = sealed;
+    longer.insert(longer.end() - 8, 8, 0);
+    EXPECT_FALSE(ae.decrypt(longer.data(), longer.size()).has_value());
+    EXPECT_FALSE(ae.decrypt(nullptr, sealed.size()).has_value());
+
+    crypto::authenticated const swapped{mac_key, data_key};
+    EXPECT_FALSE(swapped.decrypt(sealed.data(), sealed.size()).has_value());
+    EXPECT_TRUE(ae.decrypt(sealed.data(), sealed.size()).has_value());
+}
@@ -0,0 +1,155 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "../csv.h"
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    using rows = std::vector<std::vector<std::string>>;
+
+    rows collect(std::string_view const text, bee::csv::dialect const d = bee::csv::CSV) {
+        rows out;
+        bee::csv::for_each(text, d, [&](bee::csv::record const& r) {
+            auto& row = out.emplace_back();
+            for (auto const& f : r)
+                row.push_back(bee::csv::unescape(f, d.quote));
+        });
+        return out;
+    }
+
+    rows collect(std::istream& in, size_t const chunk_size) {
+        rows out;
+        bee::csv::for_each(in, bee::csv::CSV, [&](bee::csv::record const& r) {
+            auto& row = out.emplace_back();
+            for (auto const& f : r)
+                row.push_back(bee::csv::unescape(f));
+        }, chunk_size);
+        return out;
+    }
+}
+
+TEST(Csv, records) {
+    struct Test {
+        std::string input;
+        rows expected;
+    } tests[] = {
+                {"", {}},
+                {"a", {{"a"}}},
+                {"a,b,c\n", {{"a", "b", "c"}}},
+                {"a,b\nc,d", {{"a", "b"}, {"c", "d"}}},
+                {"a,,c\n,\n", {{"a", "", "c"}, {"", ""}}},
+                {"a,b\n\n\nc,d\n", {{"a", "b"}, {"c", "d"}}},
+            };
+
+    for (auto&& [input, expected]: tests)
+        EXPECT_EQ(collect(input), expected) << input;
+}
+
+TEST(Csv, quoted) {
+    struct Test {
+        std::string input;
+        rows expected;
+    } tests[] = {
+                {R"("a,b",c)", {{"a,b", "c"}}},
+                {R"("",x)", {{"", "x"}}},
+                {R"("say ""hi""",2)", {{R"(say "hi")", "2"}}},
+                {R"("""")", {{R"(")"}}},
+                {"\"line 1\nline 2\",x\ny,z\n", {{"line 1\nline 2", "x"}, {"y", "z"}}},
+                {"\"a\n\nb\"\n", {{"a\n\nb"}}},
+            };
+
+    for (auto&& [input, expected]: tests)
+        EXPECT_EQ(collect(input), expected) << input;
+}
+
+TEST(Csv, field_flags) {
+    std::vector<bee::csv::field> fields;
+    bee::csv::for_each(R"(plain,"quoted","esc""aped")", bee::csv::CSV, [&](bee::csv::record const& r) {
+        fields.assign(r.begin(), r.end());
+    });
+
+    ASSERT_EQ(fields.size(), 3);
+    EXPECT_FALSE(fields[0].quoted);
+    EXPECT_TRUE(fields[1].quoted);
+    EXPECT_FALSE(fields[1].escaped);
+    EXPECT_TRUE(fields[2].quoted);
+    EXPECT_TRUE(fields[2].escaped);
+    EXPECT_EQ(fields[2].text, R"(esc""aped)");
+}
+
+TEST(Csv, crlf) {
+    struct Test {
+        std::string input;
+        rows expected;
+    } tests[] = {
+                {"a,b\r\nc,d\r\n", {{"a", "b"}, {"c", "d"}}},
+                {"a,\r\n", {{"a", ""}}},
+                {"\"x\r\ny\",z\r\n", {{"x\r\ny", "z"}}},
+                {"a\r\n\r\nb\r\n", {{"a"}, {"b"}}},
+            };
+
+    for (auto&& [input, expected]: tests)
+        EXPECT_EQ(collect(input), expected);
+}
+
+TEST(Csv, tsv) {
+    EXPECT_EQ(collect("a\tb,c\t\"d\te\"\n", bee::csv::TSV), (rows{{"a", "b,c", "d\te"}}));
+}
+
+TEST(Csv, stream_matches_view) {
+    // Rekordy przekraczające granice porcji, także wewnątrz pól w cudzysłowach.
+    std::string text;
+    for (int i = 0; i < 500; ++i) {
+        text += std::to_string(i) + ",\"quoted, " + std::to_string(i) + "\nnext line\",\"x\"\"y\"\r\n";
+        if (i % 7 == 0)
+            text += "\n";
+    }
+    auto const expected = collect(text);
+    ASSERT_EQ(expected.size(), 500);
+
+    for (size_t const chunk : {1, 2, 3, 7, 64, 1000, 1 << 20}) {
+        std::istringstream in{text};
+        EXPECT_EQ(collect(in, chunk), expected) << "chunk = " << chunk;
+    }
+}
+
+TEST(Csv, parallel_count) {
+    std::string text;
+    for (int i = 0; i < 20'000; ++i)
+        text += "id" + std::to_string(i) + ",\"multi\nline " + std::to_string(i) + "\",value\n";
+
+    std::atomic<size_t> seen{0};
+    auto const count = bee::csv::for_each_parallel(text, bee::csv::CSV, [&](size_t, bee::csv::record const& r) {
+        if (r.size() == 3)
+            ++seen;
+    }, 8);
+    EXPECT_EQ(count, 20'000);
+    EXPECT_EQ(seen, 20'000);
+}
+
+TEST(Csv, stream_long_quoted_field) {
+    // Pole w cudzysłowach dłuższe od wielu porcji, z separatorami, końcami linii
+    // i podwojonymi cudzysłowami wypadającymi także na granicach porcji.
+    std::string value;
+    for (int i = 0; i < 5000; ++i)
+        value += i % 3 ? "ab,\n" : "\"\"";
+    std::string unescaped;
+    for (size_t i = 0; i < value.size(); ++i) {
+        unescaped += value[i];
+        if (value[i] == '"')
+            ++i;
+    }
+    std::string const text = "x,\"" + value + "\",y\r\nlast\n";
+    rows const expected{{"x", unescaped, "y"}, {"last"}};
+
+    EXPECT_EQ(collect(text), expected);
+    for (size_t const chunk : {1, 5, 63, 64, 65, 4096}) {
+        std::istringstream in{text};
+        EXPECT_EQ(collect(in, chunk), expected) << "chunk = " << chunk;
+    }
+}
@@ -0,0 +1,89 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "../hash.h"
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    // Powtarzalne dane testowe (bez zależności od generatora losowego).
+    std::vector<bee::u8> pattern(size_t const n) {
+        std::vector<bee::u8> data(n);
+        bee::u32 x = 0x12345678;
+        for (auto& b : data) {
+            x = x * 1664525 + 1013904223;
+            b = static_cast<bee::u8>(x >> 24);
+        }
+        return data;
+    }
+}
+
+TEST(Hash, crc32c) {
+    using namespace bee;
+
+    struct Test {
+        std::string input;
+        u32 expected;
+    } tests[] = {
+                {"", 0},
+                {"123456789", 0xe3069283},
+                {std::string(32, '\0'), 0x8a9136aa},
+                {std::string(32, '\xff'), 0x62a8ab43},
+            };
+
+    for (auto&& [input, expected]: tests)
+        EXPECT_EQ(hash::crc32c(input.data(), input.size()), expected);
+}
+
+TEST(Hash, crc32c_in_parts) {
+    using namespace bee;
+
+    auto const data = pattern(1000);
+    auto const whole = hash::crc32c(data.data(), data.size());
+    for (size_t split = 0; split <= data.size(); split += 37) {
+        auto const crc = hash::crc32c(data.data(), split);
+        EXPECT_EQ(hash::crc32c(data.data() + split, data.size() - split, crc), whole);
+    }
+}
+
+TEST(Hash, hash64_state_matches_hash64) {
+    using namespace bee;
+
+    auto const data = pattern(600);
+    for (size_t n = 0; n < data.size(); ++n) {
+        for (u64 const seed : {u64{0}, u64{0x9e3779b97f4a7c15}}) {
+            auto const expected = hash::hash64(data.data(), n, seed);
+
+            hash::hash64_state whole{seed};
+            whole.update(data.data(), n);
+            ASSERT_EQ(whole.digest(), expected) << "n = " << n;
+
+            // Porcje o różnych rozmiarach, także przekraczające granice pasów.
+            for (size_t const step : {1, 7, 31, 32, 33, 64, 100}) {
+                hash::hash64_state state{seed};
+                for (size_t i = 0; i < n; i += step)
+                    state.update(data.data() + i, std::min(step, n - i));
+                ASSERT_EQ(state.digest(), expected) << "n = " << n << ", step = " << step;
+            }
+        }
+    }
+}
+
+TEST(Hash, ci_hasher) {
+    using namespace bee;
+
+    hash::ci_hasher const h{};
+    hash::ci_equal const eq{};
+    std::string const upper(700, 'A');
+    std::string const lower(700, 'a');
+
+    EXPECT_EQ(h("Hello World"), hash::hash64(std::string_view{"hello world"}));
+    EXPECT_EQ(h(upper), h(lower));
+    EXPECT_EQ(h(upper), hash::hash64(std::string_view{lower}));
+    EXPECT_TRUE(eq("Content-Type", "content-type"));
+    EXPECT_FALSE(eq("Content-Type", "content-typf"));
+}
@@ -0,0 +1,136 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "../crypto/kdf/kdf.h"
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+namespace {
+    std::string hex(bee::u8 const* const data, size_t const nbytes) {
+        constexpr char digits[] = "0123456789abcdef";
+        std::string out;
+        for (size_t i = 0; i < nbytes; ++i) {
+            out += digits[data[i] >> 4];
+            out += digits[data[i] & 15];
+        }
+        return out;
+    }
+
+    std::string sha256_hex(std::string_view const data) {
+        using namespace bee::crypto;
+        bee::u8 digest[sha256::DIGEST_SIZE];
+        sha256::digest(data.data(), data.size(), digest);
+        return hex(digest, sizeof(digest));
+    }
+}
+
+TEST(Kdf, sha256) {
+    struct Test {
+        std::string input;
+        std::string expected;
+    } tests[] = {
+                {"", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+                {"abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+                {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+                    "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+                {std::string(1'000'000, 'a'), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"},
+            };
+
+    for (auto&& [input, expected]: tests)
+        EXPECT_EQ(sha256_hex(input), expected);
+}
+
+TEST(Kdf, sha256_update_in_parts) {
+    using namespace bee::crypto;
+
+    // Milion 'a' podawany porcjami o rozmiarach niebędących wielokrotnością bloku.
+    std::string const chunk(997, 'a');
+    sha256 ctx;
+    size_t left = 1'000'000;
+    while (left) {
+        auto const n = std::min(left, chunk.size());
+        ctx.update(chunk.data(), n);
+        left -= n;
+    }
+    bee::u8 digest[sha256::DIGEST_SIZE];
+    ctx.final(digest);
+    EXPECT_EQ(hex(digest, sizeof(digest)), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+TEST(Kdf, pbkdf2_sha256) {
+    using namespace bee;
+
+    // RFC 7914, rozdział 11.
+    struct Test {
+        std::string password;
+        std::string salt;
+        u32 iterations;
+        std::string expected;
+    } tests[] = {
+                {"passwd", "salt", 1,
+                    "55ac046e56e3089fec1691c22544b605f94185216dde0465e68b9d57c20dacbc"
+                    "49ca9cccf179b645991664b39d77ef317c71b845b1e30bd509112041d3a19783"},
+                {"Password", "NaCl", 80'000,
+                    "4ddcd8f60b98be21830cee5ef22701f9641a4418d04c0414aeff08876b34ab56"
+                    "a1d425a1225833549adb841b51c9b3176a272bdebba1d078478f62b397f33c8d"},
+            };
+
+    for (auto&& [password, salt, iterations, expected]: tests) {
+        u8 out[64];
+        crypto::kdf::pbkdf2_sha256(password.data(), password.size(), salt.data(), salt.size(), iterations, out, sizeof(out));
+        EXPECT_EQ(hex(out, sizeof(out)), expected);
+    }
+}
+
+TEST(Kdf, derive_and_verify) {
+    using namespace bee;
+    using namespace std::string_view_literals;
+
+    auto const password = "correct horse"sv;
+    auto const salt = "battery staple"sv;
+
+    // Liczba torów jest częścią parametrów - zmienia wynik.
+    crypto::kdf::params const cost{1000, 2};
+    auto const key = crypto::kdf::derive(password, salt, cost, 32);
+    ASSERT_EQ(key.size(), 32);
+    EXPECT_EQ(key, crypto::kdf::derive(password, salt, cost, 32));
+    EXPECT_NE(key, crypto::kdf::derive(password, salt, crypto::kdf::params{1000, 1}, 32));
+
+    EXPECT_TRUE(crypto::kdf::verify(password.data(), password.size(), salt.data(), salt.size(), cost, key.data(), key.size()));
+    auto const wrong = "correct horsf"sv;
+    EXPECT_FALSE(crypto::kdf::verify(wrong.data(), wrong.size(), salt.data(), salt.size(), cost, key.data(), key.size()));
+}
+
+TEST(Kdf, derive_lanes) {
+    using namespace bee;
+    using namespace std::string_view_literals;
+
+    auto const password = "password"sv;
+    auto const salt = "salt"sv;
+
+    // Klucz z torów liczony wprost z definicji: tor j = PBKDF2(hasło, sól || be32(j)).
+    constexpr u32 LANES = 13;
+    constexpr u32 ITERATIONS = 10;
+    u8 lanes[LANES * 32];
+    for (u32 j = 0; j < LANES; ++j) {
+        std::string lane_salt{salt};
+        for (int shift = 24; shift >= 0; shift -= 8)
+            lane_salt += static_cast<char>(j >> shift);
+        crypto::kdf::pbkdf2_sha256(password.data(), password.size(), lane_salt.data(), lane_salt.size(), ITERATIONS, lanes + j * 32, 32);
+    }
+    u8 expected[48];
+    crypto::kdf::pbkdf2_sha256(password.data(), password.size(), lanes, sizeof(lanes), 1, expected, sizeof(expected));
+
+    auto const key = crypto::kdf::derive(password, salt, crypto::kdf::params{ITERATIONS, LANES}, sizeof(expected));
+    ASSERT_EQ(key.size(), sizeof(expected));
+    EXPECT_TRUE(std::equal(key.begin(), key.end(), expected));
+
+    // Liczba torów poza zakresem - pusty wynik, bez tworzenia wątków.
+    EXPECT_TRUE(crypto::kdf::derive(password, salt, crypto::kdf::params{1, 0}, 32).empty());
+    EXPECT_TRUE(crypto::kdf::derive(password, salt, crypto::kdf::params{1, crypto::kdf::MAX_LANES + 1}, 32).empty());
+    EXPECT_TRUE(crypto::kdf::derive(password, salt, crypto::kdf::params{1, 1'000'000}, 32).empty());
+    EXPECT_EQ(crypto::kdf::derive(password, salt, crypto::kdf::params{1, crypto::kdf::MAX_LANES}, 32).size(), 32);
+}
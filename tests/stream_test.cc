@@ -0,0 +1,175 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "../crypto/blowfish/blowfish.h"
+#include "../crypto/gost/gost.h"
+#include "../crypto/stream/keystream.h"
+#include "../crypto/stream/stream.h"
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    using bytes = std::vector<bee::u8>;
+
+    bytes pattern(size_t const n, bee::u32 x = 0x12345678) {
+        bytes data(n);
+        for (auto& b : data) {
+            x = x * 1664525 + 1013904223;
+            b = static_cast<bee::u8>(x >> 24);
+        }
+        return data;
+    }
+
+    constexpr bee::u8 IV[8]{0xf0, 0xe1, 0xd2, 0xc3, 0xb4, 0xa5, 0x96, 0x87};
+
+    bee::crypto::blowfish make_blowfish() {
+        constexpr std::string_view key{"bee toolbox key"};
+        return bee::crypto::blowfish{key.data(), key.size()};
+    }
+
+    bee::crypto::gost make_gost() {
+        auto const key = pattern(bee::crypto::gost::key_size(), 77);
+        return bee::crypto::gost{key.data(), key.size()};
+    }
+
+    // Wspólne testy trybów dla obu szyfrów.
+    template<typename Cipher>
+    void check_modes(Cipher const& cipher) {
+        using namespace bee;
+
+        for (size_t const n : {1, 2, 7, 8, 9, 15, 16, 17, 31, 33, 1000}) {
+            auto const plain = pattern(n, static_cast<u32>(n));
+
+            auto const ofb = cipher.encrypt_ofb(plain.data(), n, IV);
+            ASSERT_EQ(ofb.size(), 8 + n);
+            EXPECT_TRUE(std::equal(IV, IV + 8, ofb.begin()));
+            EXPECT_EQ(cipher.decrypt_ofb(ofb.data(), ofb.size()), plain) << "n = " << n;
+
+            auto const cfb = cipher.encrypt_cfb(plain.data(), n, IV);
+            ASSERT_EQ(cfb.size(), 8 + n);
+            EXPECT_TRUE(std::equal(IV, IV + 8, cfb.begin()));
+            EXPECT_EQ(cipher.decrypt_cfb(cfb.data(), cfb.size()), plain) << "n = " << n;
+
+            // Losowy IV też jest zapisywany na początku wyniku.
+            auto const random = cipher.encrypt_ofb(plain.data(), n);
+            EXPECT_EQ(cipher.decrypt_ofb(random.data(), random.size()), plain) << "n = " << n;
+
+            // Pierwszy blok w obu trybach to P ^ E(IV); drugi blok CFB to P ^ E(C_1).
+            u32 state[2];
+            load_le32(IV, state);
+            cipher.encrypt_block(state, state);
+            u8 ks[8];
+            store_le32(ks, state);
+            for (size_t i = 0; i < std::min<size_t>(n, 8); ++i) {
+                EXPECT_EQ(ofb[8 + i], plain[i] ^ ks[i]) << "n = " << n;
+                EXPECT_EQ(cfb[8 + i], plain[i] ^ ks[i]) << "n = " << n;
+            }
+            if (n > 8) {
+                load_le32(cfb.data() + 8, state);
+                cipher.encrypt_block(state, state);
+                store_le32(ks, state);
+                for (size_t i = 8; i < std::min<size_t>(n, 16); ++i)
+                    EXPECT_EQ(cfb[8 + i], plain[i] ^ ks[i - 8]) << "n = " << n;
+            }
+        }
+
+        EXPECT_TRUE(cipher.encrypt_ofb(IV, 0, IV).empty());
+        EXPECT_TRUE(cipher.decrypt_cfb(IV, 8).empty());
+    }
+}
+
+TEST(Stream, blowfish_ofb_cfb) {
+    check_modes(make_blowfish());
+}
+
+TEST(Stream, gost_ofb_cfb) {
+    check_modes(make_gost());
+}
+
+TEST(Stream, modes_in_parts) {
+    using namespace bee;
+
+    // Rejestr przekazywany między wywołaniami - dane w porcjach dają ten sam wynik co w całości.
+    auto const bf = make_blowfish();
+    auto const plain = pattern(500);
+    auto const ofb = bf.encrypt_ofb(plain.data(), plain.size(), IV);
+    auto const cfb = bf.encrypt_cfb(plain.data(), plain.size(), IV);
+
+    for (size_t const step : {8, 16, 64, 200}) {
+        bytes out_ofb(plain.size()), out_cfb(plain.size());
+        u32 state_ofb[2], state_cfb[2];
+        load_le32(IV, state_ofb);
+        load_le32(IV, state_cfb);
+        for (size_t pos = 0; pos < plain.size(); pos += step) {
+            auto const n = std::min(step, plain.size() - pos);
+            crypto::stream::ofb(bf, state_ofb, plain.data() + pos, out_ofb.data() + pos, n);
+            crypto::stream::cfb_encrypt(bf, state_cfb, plain.data() + pos, out_cfb.data() + pos, n);
+        }
+        EXPECT_TRUE(std::equal(out_ofb.begin(), out_ofb.end(), ofb.begin() + 8)) << "step = " << step;
+        EXPECT_TRUE(std::equal(out_cfb.begin(), out_cfb.end(), cfb.begin() + 8)) << "step = " << step;
+    }
+}
+
+TEST(Stream, keystream_matches_encrypt_ofb) {
+    using namespace bee;
+
+    auto const bf = make_blowfish();
+    auto const gost = make_gost();
+
+    // Wiadomości łącznie wielokrotnie większe od bufora - wątek tła musi czekać na konsumenta.
+    auto const plain = pattern(100'000);
+    auto const check = [&](auto const& cipher) {
+        auto const expected = cipher.encrypt_ofb(plain.data(), plain.size(), IV);
+        crypto::keystream ks{cipher, IV, 4096};
+        bytes out(plain.size());
+        size_t pos = 0;
+        for (size_t i = 0; pos < plain.size(); ++i) {
+            auto const n = std::min((i * 977) % 5000 + 1, plain.size() - pos);
+            ks.apply(plain.data() + pos, out.data() + pos, n);
+            pos += n;
+        }
+        EXPECT_TRUE(std::equal(out.begin(), out.end(), expected.begin() + 8));
+    };
+    check(bf);
+    check(gost);
+
+    // Generator niszczony, zanim zużyto strumień.
+    crypto::keystream ks{bf, IV};
+    u8 byte = 0;
+    ks.apply(&byte, &byte, 1);
+}
+
+TEST(Stream, gost_matches_baseline) {
+    using namespace bee;
+
+    // Szyfrogramy sprzed przejścia na load_le32/store_le32 - format danych nie może się zmienić.
+    u8 key[32];
+    for (size_t i = 0; i < sizeof(key); ++i)
+        key[i] = static_cast<u8>(i * 11 + 5);
+    crypto::gost const gost{key, sizeof(key)};
+    u8 const iv[8]{0, 1, 2, 3, 4, 5, 6, 7};
+    bytes data(23);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<u8>(i * 37 + 11);
+
+    u32 block[2]{0x01234567, 0x89abcdef};
+    gost.encrypt_block(block, block);
+    EXPECT_EQ(block[0], 0x29aaf443u);
+    EXPECT_EQ(block[1], 0xea1ee5ffu);
+
+    auto const hex = [](bytes const& v) {
+        constexpr char digits[] = "0123456789abcdef";
+        std::string out;
+        for (auto const b : v) {
+            out += digits[b >> 4];
+            out += digits[b & 15];
+        }
+        return out;
+    };
+    EXPECT_EQ(hex(gost.encrypt_ofb(data.data(), data.size(), iv)), "00010203040506074364386f5e7e412c84f447ebec5588fa0ca6510ff7a7ab");
+    EXPECT_EQ(hex(gost.encrypt_cfb(data.data(), data.size(), iv)), "00010203040506074364386f5e7e412cdd399609a32f25d190e2cf0b288363");
+}
@@ -0,0 +1,310 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "../toolbox.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <memory_resource>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST(Text, split) {
+    using namespace bee;
+
+    struct Test {
+        std::string input;
+        std::vector<std::string> expected;
+    } tests[] = {
+                {"", {}},
+                {"a", {"a"}},
+                {"a, b", {"a", "b"}},
+                {"a, , , b", {"a", "b"}},
+                {"a,,b, ,\n,  c,, d,e, f", {"a", "b", "c", "d", "e", "f"}},
+                {"\n, , a,,b , ,\n,  c,, d,e, f, \n, ,", {"a", "b", "c", "d", "e", "f"}},
+            };
+
+    for (auto&& [input, expected]: tests) {
+        EXPECT_EQ(box::split(input, ','), expected);
+
+        std::vector<std::string_view> const views(expected.begin(), expected.end());
+        EXPECT_EQ(box::split_view(input, ','), views);
+
+        std::vector<std::string_view> lazy;
+        for (auto const token : box::split_range(input, ','))
+            lazy.push_back(token);
+        EXPECT_EQ(lazy, views);
+    }
+}
+
+TEST(Text, split_into_appends) {
+    using namespace bee;
+
+    std::vector<std::string_view> out{"first"};
+    EXPECT_EQ(box::split_into("a;b;;c", ';', out), 3);
+    EXPECT_EQ(out, (std::vector<std::string_view>{"first", "a", "b", "c"}));
+
+    std::vector<std::string> strings;
+    EXPECT_EQ(box::split_into(" x;y ; z", ';', strings), 3);
+    EXPECT_EQ(strings, (std::vector<std::string>{"x", "y", "z"}));
+}
+
+TEST(Text, split_pmr) {
+    using namespace bee;
+
+    std::string const input{"a,,b, ,\n,  c,, d,e, f"};
+    std::vector<std::string_view> const expected{"a", "b", "c", "d", "e", "f"};
+
+    std::array<std::byte, 1024> buffer;
+    std::pmr::monotonic_buffer_resource pool{buffer.data(), buffer.size()};
+    auto const views = box::split_view(input, ',', &pool);
+    EXPECT_TRUE(std::ranges::equal(views, expected));
+    auto const strings = box::split(input, ',', &pool);
+    EXPECT_TRUE(std::ranges::equal(strings, expected));
+}
+
+TEST(Text, split_on_string_and_set) {
+    using namespace bee;
+    using views = std::vector<std::string_view>;
+
+    EXPECT_EQ(box::split_view("a, b, c", ", "), (views{"a", "b", "c"}));
+    EXPECT_EQ(box::split_view("a||||b||", "||"), (views{"a", "b"}));
+    EXPECT_EQ(box::split_view("abc", ""), (views{"abc"}));
+    EXPECT_EQ(box::split_view_any("a;b,c\td", ";,\t"), (views{"a", "b", "c", "d"}));
+
+    views lazy;
+    for (auto const token : box::split_range_any("1;2,,3", ";,"))
+        lazy.push_back(token);
+    EXPECT_EQ(lazy, (views{"1", "2", "3"}));
+
+    views by_string;
+    for (auto const token : box::split_range("x || y ||z", "||"))
+        by_string.push_back(token);
+    EXPECT_EQ(by_string, (views{"x", "y", "z"}));
+
+    std::vector<std::string> strings;
+    EXPECT_EQ(box::split_into("x || y ||z", "||", strings), 3);
+    EXPECT_EQ(strings, (std::vector<std::string>{"x", "y", "z"}));
+    EXPECT_EQ(box::split_into("a;b,c", simd::byte_set{";,"}, strings), 3);
+    EXPECT_EQ(strings.back(), "c");
+}
+
+TEST(Text, join) {
+    using namespace bee;
+
+    struct Test {
+        std::vector<std::string> input;
+        std::string expected;
+    } tests[] = {
+                {{}, ""},
+                {{"a"}, "a"},
+                {{"a", "b", "", "c", ""}, "a,b,c"},
+                {{"", ""}, ""},
+            };
+
+    for (auto&& [input, expected]: tests) {
+        EXPECT_EQ(box::join(input, ","), expected);
+
+        // Zakres jednoprzebiegowy - bez wcześniejszego liczenia rozmiaru.
+        std::istringstream in{box::join(input, " ")};
+        EXPECT_EQ(box::join(std::ranges::istream_view<std::string>(in), ","), expected);
+    }
+}
+
+TEST(Text, join_into) {
+    using namespace bee;
+
+    struct user {
+        std::string name;
+        int age;
+    };
+    std::list<user> const users{{"ala", 1}, {"", 2}, {"ola", 3}};
+
+    std::string out{"users: "};
+    box::join_into(out, users, ", ", &user::name);
+    EXPECT_EQ(out, "users: ala, ola");
+
+    // Dopisywanie do bufora z zapasem pojemności.
+    std::string buffer;
+    buffer.reserve(1000);
+    buffer = "x";
+    std::vector<std::string_view> const parts{"a", "bb", "ccc"};
+    EXPECT_EQ(box::join_into(buffer, parts, "-"), "xa-bb-ccc");
+    EXPECT_EQ(buffer.size(), 9);
+}
+
+TEST(Text, join_projection_by_value) {
+    using namespace bee;
+
+    // Projekcja zwraca std::string przez wartość - tekst musi żyć podczas kopiowania.
+    std::vector<int> const numbers{1, 22, 0, 333, 123456789};
+    auto const to_text = [](int const i) { return i ? std::to_string(i) : std::string{}; };
+    EXPECT_EQ(box::join(numbers, ", ", to_text), "1, 22, 333, 123456789");
+
+    std::string out{">"};
+    box::join_into(out, numbers | std::views::take(2), "-", to_text);
+    EXPECT_EQ(out, ">1-22");
+
+    // Długie teksty (poza SSO) w zakresie jednoprzebiegowym.
+    std::istringstream in{"1 2 3"};
+    auto const long_text = [](std::string const& s) { return std::string(40, s[0]); };
+    EXPECT_EQ(box::join(std::ranges::istream_view<std::string>(in), "|", long_text),
+              std::string(40, '1') + "|" + std::string(40, '2') + "|" + std::string(40, '3'));
+}
+
+TEST(Text, parse_integral) {
+    using namespace bee;
+
+    EXPECT_EQ(box::parse<int>("0"), 0);
+    EXPECT_EQ(box::parse<int>("-42"), -42);
+    EXPECT_EQ(box::parse<int>("2147483647"), std::numeric_limits<int>::max());
+    EXPECT_EQ(box::parse<int>("-2147483648"), std::numeric_limits<int>::min());
+    EXPECT_EQ(box::parse<u64>("18446744073709551615"), std::numeric_limits<u64>::max());
+    EXPECT_EQ(box::parse<i64>("-9223372036854775808"), std::numeric_limits<i64>::min());
+    EXPECT_EQ(box::parse<int>("00000000000000000000123"), 123);
+    EXPECT_EQ(box::parse<u32>("12345678"), 12345678u);
+    EXPECT_EQ(box::parse<u64>("1234567890123456"), 1234567890123456u);
+    EXPECT_EQ(box::parse<int>("ff", 16), 255);
+    EXPECT_EQ(box::parse<std::int8_t>("-128"), -128);
+
+    struct Test {
+        std::string_view input;
+        std::errc expected;
+    } errors[] = {
+                {"", std::errc::invalid_argument},
+                {"-", std::errc::invalid_argument},
+                {"+1", std::errc::invalid_argument},
+                {" 1", std::errc::invalid_argument},
+                {"1 ", std::errc::invalid_argument},
+                {"12a", std::errc::invalid_argument},
+                {"1234567a", std::errc::invalid_argument},
+                {"12345678a", std::errc::invalid_argument},
+                {"2147483648", std::errc::result_out_of_range},
+                {"-2147483649", std::errc::result_out_of_range},
+                {"99999999999999999999", std::errc::result_out_of_range},
+            };
+
+    for (auto&& [input, expected]: errors) {
+        auto const result = box::parse<int>(input);
+        ASSERT_FALSE(result.has_value()) << input;
+        EXPECT_EQ(result.error(), expected) << input;
+    }
+
+    EXPECT_EQ(box::parse<unsigned>("-1").error(), std::errc::invalid_argument);
+    EXPECT_EQ(box::parse<u8>("256").error(), std::errc::result_out_of_range);
+}
+
+TEST(Text, parse_floating_point) {
+    using namespace bee;
+
+    EXPECT_EQ(box::parse<double>("1.5"), 1.5);
+    EXPECT_EQ(box::parse<double>("-2e3"), -2000.0);
+    EXPECT_EQ(box::parse<float>("0.25"), 0.25f);
+    EXPECT_EQ(box::parse<double>("1.5x").error(), std::errc::invalid_argument);
+    EXPECT_EQ(box::parse<double>("").error(), std::errc::invalid_argument);
+    EXPECT_EQ(box::parse<double>("1e999").error(), std::errc::result_out_of_range);
+    EXPECT_EQ(box::parse<double>("2e3", std::chars_format::fixed).error(), std::errc::invalid_argument);
+}
+
+namespace {
+    template<typename T>
+    concept parsable = requires(std::string_view const sv) { bee::box::parse<T>(sv); };
+}
+
+TEST(Text, parse_types) {
+    using namespace bee;
+
+    static_assert(parsable<char> && parsable<signed char> && parsable<unsigned char>);
+    static_assert(parsable<short> && parsable<long long> && parsable<unsigned long>);
+    static_assert(parsable<float> && parsable<double>);
+    static_assert(!parsable<bool>);
+    static_assert(!parsable<wchar_t> && !parsable<char8_t> && !parsable<char16_t> && !parsable<char32_t>);
+
+    EXPECT_EQ(box::parse<char>("65"), 'A');
+}
+
+TEST(Text, trim) {
+    using namespace bee;
+
+    // Ciągi białych znaków wokół szerokości wektorów, po obu stronach.
+    constexpr std::string_view spaces{" \t\n\v\f\r"};
+    std::vector<size_t> lengths{0, 1, 2, 3};
+    for (size_t const width : {16, 32, 64, 128})
+        for (size_t const n : {width - 1, width, width + 1})
+            lengths.push_back(n);
+
+    for (auto const left : lengths) {
+        for (auto const right : {size_t{0}, size_t{1}, size_t{17}, size_t{64}, size_t{65}}) {
+            std::string text;
+            for (size_t i = 0; i < left; ++i)
+                text += spaces[i % spaces.size()];
+            auto const body_at = text.size();
+            text += "a \t\xa0" "b";
+            auto const body_end = text.size();
+            for (size_t i = 0; i < right; ++i)
+                text += spaces[(i + 3) % spaces.size()];
+
+            auto const view = std::string_view{text};
+            EXPECT_EQ(box::trim_view_left(view), view.substr(body_at)) << left << ", " << right;
+            EXPECT_EQ(box::trim_view_right(view), view.substr(0, body_end)) << left << ", " << right;
+            EXPECT_EQ(box::trim_view(view), view.substr(body_at, body_end - body_at)) << left << ", " << right;
+            EXPECT_EQ(box::trim_view(view).data(), text.data() + body_at);
+            EXPECT_EQ(box::trim_left(text), view.substr(body_at));
+            EXPECT_EQ(box::trim_right(text), view.substr(0, body_end));
+            EXPECT_EQ(box::trim(text), view.substr(body_at, body_end - body_at));
+        }
+
+        // Same białe znaki - wynik pusty.
+        std::string const blank(left, ' ');
+        EXPECT_TRUE(box::trim_view_left(blank).empty());
+        EXPECT_TRUE(box::trim_view_right(blank).empty());
+        EXPECT_TRUE(box::trim_view(blank).empty());
+    }
+
+    // NEL (0x85) i NBSP (0xa0) nie są białymi znakami w locale "C".
+    EXPECT_EQ(box::trim_view("\x85" " x \xa0"), "\x85" " x \xa0");
+    EXPECT_EQ(box::trim_view(std::string(40, ' ') + "\xa0"), "\xa0");
+}
+
+TEST(Text, lines) {
+    using namespace bee;
+    using views = std::vector<std::string_view>;
+
+    auto const collect = [](std::string_view const text) {
+        views out;
+        for (auto const line : box::lines(text))
+            out.push_back(line);
+        return out;
+    };
+
+    struct Test {
+        std::string input;
+        views expected;
+    } tests[] = {
+                {"", {}},
+                {"x", {"x"}},
+                {"a\nb", {"a", "b"}},
+                {"a\r\nb\r\n", {"a", "b"}},
+                {"\n\n", {"", ""}},
+                {"a\n\n", {"a", ""}},
+                {"\r\n", {""}},
+                {"a\rb\n", {"a\rb"}},
+            };
+
+    for (auto&& [input, expected]: tests)
+        EXPECT_EQ(collect(input), expected) << input;
+
+    // Linie dłuższe od szerokości wektora - koniec linii w różnych miejscach bloku.
+    for (size_t const n : {15, 16, 17, 31, 32, 33, 63, 64, 65, 200}) {
+        std::string const a(n, 'a');
+        std::string const b(n + 1, 'b');
+        EXPECT_EQ(collect(a + "\n" + b + "\r\n\n" + a), (views{a, b, "", a})) << "n = " << n;
+    }
+}
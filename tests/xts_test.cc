@@ -0,0 +1,172 @@
+//
+// Created by piotr on 18.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "../crypto/blowfish/blowfish.h"
+#include "../crypto/xts/sector_file.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+    using bytes = std::vector<bee::u8>;
+
+    bytes pattern(size_t const n, bee::u32 x = 0x12345678) {
+        bytes data(n);
+        for (auto& b : data) {
+            x = x * 1664525 + 1013904223;
+            b = static_cast<bee::u8>(x >> 24);
+        }
+        return data;
+    }
+
+    bee::crypto::blowfish make_cipher(std::string_view const key) {
+        return bee::crypto::blowfish{key.data(), key.size()};
+    }
+
+    // Plik tymczasowy usuwany po teście.
+    struct temp_file {
+        std::filesystem::path path = std::filesystem::temp_directory_path()
+            / ("bee_xts_" + std::to_string(getpid()) + "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        ~temp_file() { std::filesystem::remove(path); }
+    };
+}
+
+TEST(Xts, sector_round_trip) {
+    using namespace bee;
+
+    auto const data_key = make_cipher("data key");
+    auto const tweak_key = make_cipher("tweak key");
+    crypto::xts const mode{data_key, tweak_key};
+
+    for (size_t const n : {8, 16, 24, 512, 4096}) {
+        auto const plain = pattern(n);
+        bytes cipher(n);
+        ASSERT_TRUE(mode.encrypt_sector(7, plain.data(), cipher.data(), n));
+        EXPECT_NE(cipher, plain);
+
+        bytes back(n);
+        ASSERT_TRUE(mode.decrypt_sector(7, cipher.data(), back.data(), n));
+        EXPECT_EQ(back, plain) << "n = " << n;
+
+        // Inny sektor - inny szyfrogram; zły numer sektora nie odszyfrowuje danych.
+        bytes other(n);
+        ASSERT_TRUE(mode.encrypt_sector(8, plain.data(), other.data(), n));
+        EXPECT_NE(other, cipher);
+        ASSERT_TRUE(mode.decrypt_sector(8, cipher.data(), back.data(), n));
+        EXPECT_NE(back, plain);
+
+        // W miejscu.
+        auto in_place = plain;
+        ASSERT_TRUE(mode.encrypt_sector(7, in_place.data(), in_place.data(), n));
+        EXPECT_EQ(in_place, cipher);
+        ASSERT_TRUE(mode.decrypt_sector(7, in_place.data(), in_place.data(), n));
+        EXPECT_EQ(in_place, plain);
+    }
+
+    bytes buffer(20);
+    EXPECT_FALSE(mode.encrypt_sector(0, buffer.data(), buffer.data(), 12));
+    EXPECT_FALSE(mode.decrypt_sector(0, buffer.data(), buffer.data(), 20));
+}
+
+TEST(Xts, matches_definition) {
+    using namespace bee;
+
+    auto const data_key = make_cipher("data key");
+    auto const tweak_key = make_cipher("tweak key");
+    crypto::xts const mode{data_key, tweak_key};
+
+    // Identyczne bloki jawnego tekstu - w sektorze dają różne bloki szyfrogramu.
+    u64 const sector = 0x1'0000'0003;
+    bytes const plain(4 * 8, 0x42);
+    bytes cipher(plain.size());
+    ASSERT_TRUE(mode.encrypt_sector(sector, plain.data(), cipher.data(), plain.size()));
+
+    // T = E_tweak(sektor), C_j = E_data(P_j ^ T_j) ^ T_j, T_{j+1} = T_j * x.
+    u32 const number[2]{static_cast<u32>(sector), static_cast<u32>(sector >> 32)};
+    u32 t[2];
+    tweak_key.encrypt_block(number, t);
+    for (size_t j = 0; j < plain.size() / 8; ++j) {
+        u32 block[2];
+        load_le32(plain.data() + 8 * j, block);
+        block[0] ^= t[0];
+        block[1] ^= t[1];
+        data_key.encrypt_block(block, block);
+        block[0] ^= t[0];
+        block[1] ^= t[1];
+        u8 expected[8];
+        store_le32(expected, block);
+        EXPECT_TRUE(std::equal(expected, expected + 8, cipher.begin() + 8 * j)) << "j = " << j;
+
+        auto const carry = t[1] >> 31;
+        t[1] = t[1] << 1 | t[0] >> 31;
+        t[0] = t[0] << 1 ^ carry * 0x1b;
+    }
+}
+
+TEST(Xts, sector_file_random_access) {
+    using namespace bee;
+
+    auto const data_key = make_cipher("data key");
+    auto const tweak_key = make_cipher("tweak key");
+    crypto::xts const mode{data_key, tweak_key};
+    temp_file const tmp;
+    constexpr size_t SECTOR = 512;
+    auto const round_up = [](size_t const n) { return (n + SECTOR - 1) / SECTOR * SECTOR; };
+
+    // Zapisy pod losowe pozycje (także za końcem pliku i przez granice sektorów)
+    // porównywane z wzorcowym wektorem.
+    bytes model;
+    {
+        auto file = crypto::sector_file<crypto::blowfish>::open(tmp.path.string(), mode, true, SECTOR);
+        ASSERT_TRUE(file.has_value());
+        EXPECT_EQ(file->size(), 0);
+
+        u32 x = 2024;
+        auto const next = [&x](u32 const bound) {
+            x = x * 1664525 + 1013904223;
+            return (x >> 8) % bound;
+        };
+        for (int i = 0; i < 200; ++i) {
+            auto const offset = next(6000);
+            auto const data = pattern(next(1500) + 1, x);
+            ASSERT_TRUE(file->write(offset, data.data(), data.size()));
+            if (model.size() < offset + data.size())
+                model.resize(offset + data.size());
+            std::ranges::copy(data, model.begin() + offset);
+            ASSERT_EQ(file->size(), round_up(model.size()));
+
+            auto const at = next(7000);
+            bytes got(next(2000));
+            auto const n = file->read(at, got.data(), got.size());
+            ASSERT_TRUE(n.has_value());
+            auto const end = std::max<size_t>(at, std::min(at + got.size(), round_up(model.size())));
+            ASSERT_EQ(*n, end - at) << "at = " << at;
+            for (size_t k = 0; k < *n; ++k)
+                ASSERT_EQ(got[k], at + k < model.size() ? model[at + k] : 0) << "at = " << at << ", k = " << k;
+        }
+    }
+
+    // Plik na dysku jest zaszyfrowany, po ponownym otwarciu (tylko do odczytu) daje te same dane.
+    std::ifstream raw{tmp.path, std::ios::binary};
+    bytes const stored{std::istreambuf_iterator<char>{raw}, {}};
+    ASSERT_EQ(stored.size(), round_up(model.size()));
+    EXPECT_FALSE(std::equal(model.begin(), model.begin() + SECTOR, stored.begin()));
+
+    auto file = crypto::sector_file<crypto::blowfish>::open(tmp.path.string(), mode, false, SECTOR);
+    ASSERT_TRUE(file.has_value());
+    bytes all(stored.size());
+    ASSERT_EQ(file->read(0, all.data(), all.size()), all.size());
+    EXPECT_TRUE(std::equal(model.begin(), model.end(), all.begin()));
+    EXPECT_TRUE(std::all_of(all.begin() + model.size(), all.end(), [](u8 const b) { return b == 0; }));
+    EXPECT_FALSE(file->write(0, all.data(), 1));
+
+    EXPECT_FALSE(crypto::sector_file<crypto::blowfish>::open(tmp.path.string(), mode, false, 100).has_value());
+    EXPECT_FALSE(crypto::sector_file<crypto::blowfish>::open(tmp.path.string(), mode, false, 0).has_value());
+}
@@ -27,7 +27,6 @@
 #include <unistd.h>
 #include <format>
 #include <pwd.h>
-#include <sstream>
 #include <filesystem>
 
 namespace bee {
@@ -63,24 +62,15 @@ namespace bee {
         char const delimiter) noexcept
     {
         // Lepiej policzyć delimitery niż później realokować wektor.
-        auto const n = std::accumulate(
-                text.cbegin(),
-                text.cend(),
-                size_t{},
-                [delimiter](int const count, char const c) {
-                    return c == delimiter ? count + 1 : count;
-                }
-        );
+        auto const n = simd::count_byte(text.data(), text.size(), delimiter);
 
         // Wektor o wstępnie zaalokowanej liczbie elementów.
         std::vector<std::string> tokens{};
         tokens.reserve(n + 1);
 
-        std::string token{};
-        std::istringstream stream{text};
-        while (std::getline(stream, token, delimiter))
-            if (auto line = trim(token); !line.empty())
-                tokens.push_back(std::move(line));
+        token_range::for_each(text, delimiter, [&tokens](std::string_view const token) {
+            tokens.emplace_back(token);
+        });
 
         tokens.shrink_to_fit();
         return tokens;
@@ -90,61 +80,172 @@ namespace bee {
         std::string&& text,
         char const delimiter) noexcept
     {
-        // Lepiej policzyć delimitery niż później realokować wektor.
-        auto const n = std::accumulate(
-                text.cbegin(),
-                text.cend(),
-                size_t{},
-                [delimiter](int const count, char const c) {
-                    return c == delimiter ? count + 1 : count;
-                }
-        );
+        // Fragmenty i tak są kopiowane do nowych stringów - tekst wystarczy tylko odczytać.
+        return split(static_cast<std::string const&>(text), delimiter);
+    }
 
-        // Wektor o wstępnie zaalokowanej liczbie elementów.
-        std::vector<std::string> tokens{};
-        tokens.reserve(n + 1);
+    // Podział tekstu bez kopiowania - wynikiem są widoki na przysłany tekst.
+    std::vector<std::string_view> box::split_view(
+        std::string_view const text,
+        char const delimiter) noexcept
+    {
+        // Liczba delimiterów wyznacza górną granicę liczby fragmentów.
+        std::vector<std::string_view> tokens{};
+        tokens.reserve(simd::count_byte(text.data(), text.size(), delimiter) + 1);
+        token_range::for_each(text, delimiter, [&tokens](std::string_view const token) {
+            tokens.push_back(token);
+        });
+        return tokens;
+    }
 
-        std::string token{};
-        std::istringstream stream{std::move(text)};
-        while (std::getline(stream, token, delimiter))
-            if (auto line = trim(token); !line.empty())
-                tokens.push_back(std::move(line));
+    // Podział tekstu rozdzielonego ciągiem znaków - widoki na przysłany tekst.
+    std::vector<std::string_view> box::split_view(
+        std::string_view const text,
+        std::string_view const delimiter) noexcept
+    {
+        std::vector<std::string_view> tokens{};
+        split_into(text, delimiter, tokens);
+        return tokens;
+    }
 
-        tokens.shrink_to_fit();
+    // Podział tekstu rozdzielonego dowolnym ze znaków 'delimiters' - widoki na przysłany tekst.
+    std::vector<std::string_view> box::split_view_any(
+        std::string_view const text,
+        std::string_view const delimiters) noexcept
+    {
+        std::vector<std::string_view> tokens{};
+        split_into(text, simd::byte_set{delimiters}, tokens);
         return tokens;
     }
 
+    namespace {
+        // Proste odwzorowanie wielkości liter (znak na znak) dla Latin-1, Latin Extended-A,
+        // greki i cyrylicy. Wszystkie te znaki zapisywane są w UTF-8 dwoma bajtami.
+        char32_t lower_of(char32_t const c) noexcept {
+            if (c - U'A' < 26)
+                return c + 0x20;
+            if (c >= 0xc0 && c <= 0xde && c != 0xd7)
+                return c + 0x20;
+            if (c >= 0x100 && c <= 0x17f) {
+                if (c == 0x130)
+                    return U'i';
+                if (c == 0x178)
+                    return 0xff;
+                if (c == 0x131 || c == 0x138 || c == 0x149 || c == 0x17f)
+                    return c;
+                // Od Ĺ do Ň i od Ź do Ž wielkie litery mają kody nieparzyste, w pozostałych parach - parzyste.
+                if ((c >= 0x139 && c <= 0x148) || (c >= 0x179 && c <= 0x17e))
+                    return (c & 1) ? c + 1 : c;
+                return (c & 1) ? c : c + 1;
+            }
+            if (c >= 0x391 && c <= 0x3ab && c != 0x3a2)
+                return c + 0x20;
+            if (c == 0x386)
+                return 0x3ac;
+            if (c >= 0x388 && c <= 0x38a)
+                return c + 0x25;
+            if (c == 0x38c)
+                return 0x3cc;
+            if (c == 0x38e || c == 0x38f)
+                return c + 0x3f;
+            if (c >= 0x400 && c <= 0x40f)
+                return c + 0x50;
+            if (c >= 0x410 && c <= 0x42f)
+                return c + 0x20;
+            return c;
+        }
+
+        char32_t upper_of(char32_t const c) noexcept {
+            if (c - U'a' < 26)
+                return c - 0x20;
+            if (c >= 0xe0 && c <= 0xfe && c != 0xf7)
+                return c - 0x20;
+            if (c == 0xff)
+                return 0x178;
+            if (c == 0xb5)
+                return 0x39c;
+            if (c >= 0x100 && c <= 0x17f) {
+                if (c == 0x131)
+                    return U'I';
+                if (c == 0x17f)
+                    return U'S';
+                if (c == 0x130 || c == 0x138 || c == 0x149 || c == 0x178)
+                    return c;
+                if ((c >= 0x139 && c <= 0x148) || (c >= 0x179 && c <= 0x17e))
+                    return (c & 1) ? c : c - 1;
+                return (c & 1) ? c - 1 : c;
+            }
+            if (c >= 0x3b1 && c <= 0x3cb)
+                return c == 0x3c2 ? 0x3a3 : c - 0x20;
+            if (c == 0x3ac)
+                return 0x386;
+            if (c >= 0x3ad && c <= 0x3af)
+                return c - 0x25;
+            if (c == 0x3cc)
+                return 0x38c;
+            if (c == 0x3cd || c == 0x3ce)
+                return c - 0x3f;
+            if (c >= 0x430 && c <= 0x44f)
+                return c - 0x20;
+            if (c >= 0x450 && c <= 0x45f)
+                return c - 0x50;
+            return c;
+        }
+
+        // Ciągi ASCII (sprawdzane po 8 bajtów) zamieniane są wektorowo,
+        // dwubajtowe znaki UTF-8 - przez odwzorowanie 'map'; pozostałe bajty kopiowane są bez zmian.
+        template<void (*Ascii)(void const*, void*, size_t) noexcept, char32_t (*Map)(char32_t) noexcept>
+        std::string utf8_case(std::string_view const sv) {
+            auto const p = reinterpret_cast<u8 const*>(sv.data());
+            auto const n = sv.size();
+            std::string buffer;
+            buffer.reserve(n);
+
+            for (size_t i = 0; i < n;) {
+                auto j = i;
+                while (j + 8 <= n && !(load_le64(p + j) & 0x8080'8080'8080'8080))
+                    j += 8;
+                while (j < n && p[j] < 0x80)
+                    ++j;
+                if (j > i) {
+                    auto const offset = buffer.size();
+                    buffer.resize(offset + (j - i));
+                    Ascii(p + i, buffer.data() + offset, j - i);
+                    i = j;
+                    continue;
+                }
+
+                if ((p[i] & 0xe0) == 0xc0 && p[i] >= 0xc2 && i + 1 < n && (p[i + 1] & 0xc0) == 0x80) {
+                    auto const c = Map(static_cast<char32_t>((p[i] & 0x1f) << 6 | (p[i + 1] & 0x3f)));
+                    if (c < 0x80)
+                        buffer += static_cast<char>(c);
+                    else {
+                        buffer += static_cast<char>(0xc0 | c >> 6);
+                        buffer += static_cast<char>(0x80 | (c & 0x3f));
+                    }
+                    i += 2;
+                }
+                else
+                    buffer += sv[i++];
+            }
+            return buffer;
+        }
+    }
+
+    std::string box::utf8_to_lower(std::string_view const sv) {
+        return utf8_case<simd::ascii_lower, lower_of>(sv);
+    }
+
+    std::string box::utf8_to_upper(std::string_view const sv) {
+        return utf8_case<simd::ascii_upper, upper_of>(sv);
+    }
+
     auto box::join(
         std::span<std::string> data,
         std::string const &delimiter) noexcept
     -> std::string
     {
-        if (data.empty())
-            return {};
-
-        const auto tokens_size = std::accumulate(
-            std::begin(data),
-            std::end(data),
-            size_t{},
-            [](auto const count, auto const& str) {
-               return count + str.size();
-            });
-
-        // String o wstępnie zaalokowanej liczbie znaków.
-        std::string buffer{};
-        buffer.reserve(tokens_size + data.size() - 1);
-
-        // Ze spanu kopiujemy elementy od początku, ale bez ostatniego elementu.
-        std::ranges::for_each(data, [&buffer, delimiter](auto&& token) {
-            if (!token.empty())
-                buffer += token + delimiter;
-        });
-
-        if (buffer.ends_with(delimiter))
-            buffer.resize(buffer.size() - delimiter.size());
-        buffer.shrink_to_fit();
-
-        return buffer;
+        return join(data, std::string_view{delimiter});
     }
 
     bool box::create_dirs(std::string_view const path) {
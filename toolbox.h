@@ -26,20 +26,281 @@
 -------------------------------------------------------------------*/
 #include "types.h"
 #include "lzav.h"
+#include "csprng.h"
+#include "simd.h"
 #include <iostream>
 #include <algorithm>
 #include <string>
 #include <format>
 #include <random>
 #include <chrono>
+#include <charconv>
+#include <expected>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <ranges>
+#include <string_view>
+#include <vector>
 #include <pwd.h>
 #include <unistd.h>
 
 namespace bee {
+    /// Typy całkowite obsługiwane przez std::from_chars: standardowe typy ze znakiem
+    /// i bez znaku oraz char (bez bool, wchar_t, char8_t, char16_t i char32_t).
+    template<typename T>
+    concept Integer = std::same_as<T, char>
+        || std::same_as<T, signed char> || std::same_as<T, unsigned char>
+        || std::same_as<T, short> || std::same_as<T, unsigned short>
+        || std::same_as<T, int> || std::same_as<T, unsigned int>
+        || std::same_as<T, long> || std::same_as<T, unsigned long>
+        || std::same_as<T, long long> || std::same_as<T, unsigned long long>;
+
+    /// Leniwy podział tekstu na fragmenty rozdzielone delimiterem:
+    /// znakiem (char), ciągiem znaków (std::string_view) lub dowolnym znakiem ze zbioru (simd::byte_set).
+    /// Fragmenty (widoki na przysłany tekst) mają obcięte białe znaki z obu stron,
+    /// puste fragmenty są pomijane - tak jak w box::split.
+    /// Kolejny fragment wyznaczany jest dopiero przy przejściu iteratora, bez alokacji.
+    /// Tekst (i ciąg delimitera) musi istnieć dłużej niż zakres i jego iteratory.
+    template<typename Delimiter>
+    class basic_token_range {
+        std::string_view text_;
+        Delimiter delimiter_;
+    public:
+        class iterator {
+            std::string_view rest_{};
+            std::string_view token_{};
+            Delimiter delimiter_{};
+            bool end_{true};
+        public:
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            iterator() = default;
+            iterator(std::string_view const text, Delimiter const& delimiter) noexcept
+                : rest_{text}, delimiter_{delimiter}, end_{false}
+            {
+                next();
+            }
+
+            std::string_view operator*() const noexcept { return token_; }
+            std::string_view const* operator->() const noexcept { return &token_; }
+
+            iterator& operator++() noexcept {
+                next();
+                return *this;
+            }
+            iterator operator++(int) noexcept {
+                auto const tmp = *this;
+                next();
+                return tmp;
+            }
+
+            bool operator==(iterator const& rhs) const noexcept {
+                return end_ == rhs.end_ && (end_ || token_.data() == rhs.token_.data());
+            }
+            bool operator==(std::default_sentinel_t) const noexcept {
+                return end_;
+            }
+
+        private:
+            void next() noexcept {
+                while (rest_.data()) {
+                    std::string_view piece;
+                    if (auto const pos = find(rest_, delimiter_); pos != rest_.size()) {
+                        piece = rest_.substr(0, pos);
+                        rest_.remove_prefix(pos + length(delimiter_));
+                    }
+                    else {
+                        piece = rest_;
+                        rest_ = {};
+                    }
+                    if (token_ = trimmed(piece); !token_.empty())
+                        return;
+                }
+                token_ = {};
+                end_ = true;
+            }
+        };
+
+        basic_token_range(std::string_view const text, Delimiter const& delimiter) noexcept
+            : text_{text}, delimiter_{delimiter} {}
+
+        /// Wywołanie fn(token) dla wszystkich fragmentów tekstu (gorliwie, bez iteratora).
+        /// Pozycje delimiterów jednoznakowych wyznaczane są maskami dla 64-bajtowych porcji.
+        template<typename Fn>
+        static void for_each(std::string_view const text, Delimiter const& delimiter, Fn&& fn) {
+            size_t start = 0;
+            auto const emit = [&](size_t const end) {
+                if (auto const token = trimmed(text.substr(start, end - start)); !token.empty())
+                    fn(token);
+                start = end + length(delimiter);
+            };
+            if constexpr (std::same_as<Delimiter, char>)
+                simd::for_each_byte(text.data(), text.size(), delimiter, emit);
+            else if constexpr (std::same_as<Delimiter, simd::byte_set>)
+                simd::for_each_any(text.data(), text.size(), delimiter, emit);
+            else {
+                // Kolejne (nienakładające się) wystąpienia ciągu.
+                while (start < text.size()) {
+                    auto const pos = find(text.substr(start), delimiter);
+                    if (pos == text.size() - start)
+                        break;
+                    emit(start + pos);
+                }
+            }
+            emit(text.size());
+        }
+
+        /// Pozycja pierwszego delimitera w tekście lub text.size(), jeśli go nie ma.
+        /// Pusty ciąg znaków nie dzieli tekstu.
+        static size_t find(std::string_view const text, Delimiter const& delimiter) noexcept {
+            if constexpr (std::same_as<Delimiter, char>)
+                return simd::find_byte(text.data(), text.size(), delimiter);
+            else if constexpr (std::same_as<Delimiter, simd::byte_set>)
+                return simd::find_any(text.data(), text.size(), delimiter);
+            else
+                return delimiter.empty()
+                    ? text.size()
+                    : simd::find_substr(text.data(), text.size(), delimiter.data(), delimiter.size());
+        }
+
+        static size_t length(Delimiter const& delimiter) noexcept {
+            if constexpr (std::same_as<Delimiter, std::string_view>)
+                return delimiter.size();
+            else
+                return 1;
+        }
+
+        static std::string_view trimmed(std::string_view sv) noexcept {
+            sv.remove_prefix(simd::leading_space(sv.data(), sv.size()));
+            sv.remove_suffix(simd::trailing_space(sv.data(), sv.size()));
+            return sv;
+        }
+
+        [[nodiscard]] iterator begin() const noexcept {
+            // Pusty tekst o adresie nullptr nie ma żadnych fragmentów.
+            return text_.data() ? iterator{text_, delimiter_} : iterator{};
+        }
+        [[nodiscard]] static std::default_sentinel_t end() noexcept { return {}; }
+    };
+
+    using token_range = basic_token_range<char>;
+
+    /// Kolejne linie tekstu (widoki bez znaku końca linii; "\r\n" traktowane jak "\n").
+    /// Puste linie są zachowywane; znak '\n' na końcu tekstu nie tworzy dodatkowej pustej linii.
+    /// Końce linii wyszukiwane są wektorowo (simd::find_byte).
+    class line_range {
+        std::string_view text_;
+    public:
+        class iterator {
+            std::string_view rest_{};
+            std::string_view line_{};
+            bool end_{true};
+        public:
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            iterator() = default;
+            explicit iterator(std::string_view const text) noexcept : rest_{text}, end_{false} {
+                next();
+            }
+
+            std::string_view operator*() const noexcept { return line_; }
+            std::string_view const* operator->() const noexcept { return &line_; }
+
+            iterator& operator++() noexcept {
+                next();
+                return *this;
+            }
+            iterator operator++(int) noexcept {
+                auto const tmp = *this;
+                next();
+                return tmp;
+            }
+
+            bool operator==(iterator const& rhs) const noexcept {
+                return end_ == rhs.end_ && (end_ || line_.data() == rhs.line_.data());
+            }
+            bool operator==(std::default_sentinel_t) const noexcept {
+                return end_;
+            }
+
+        private:
+            void next() noexcept {
+                if (rest_.empty()) {
+                    line_ = {};
+                    end_ = true;
+                    return;
+                }
+                auto const pos = simd::find_byte(rest_.data(), rest_.size(), '\n');
+                line_ = rest_.substr(0, pos);
+                rest_.remove_prefix(std::min(pos + 1, rest_.size()));
+                if (line_.ends_with('\r'))
+                    line_.remove_suffix(1);
+            }
+        };
+
+        explicit line_range(std::string_view const text) noexcept : text_{text} {}
+
+        [[nodiscard]] iterator begin() const noexcept { return iterator{text_}; }
+        [[nodiscard]] static std::default_sentinel_t end() noexcept { return {}; }
+    };
+
     class box {
         static constexpr auto DECIMAL_POINT = ',';
         static constexpr auto THOUSAND_SEPARATOR = '.';
         static constexpr auto DIGITS_AFTER_DECIMAL_POINT = 2;
+
+        // Najwięcej cyfr, których wartość na pewno mieści się w u64.
+        static constexpr size_t MAX_FAST_DIGITS = 19;
+
+        // Szybka ścieżka parse dla systemu dziesiętnego: cyfry po 8 naraz (SWAR), reszta pojedynczo.
+        // Zwraca nic, gdy tekst nie jest w całości krótką liczbą - wtedy decyduje std::from_chars,
+        // który ustala też rodzaj błędu.
+        template<Integer T>
+        static std::optional<T> parse_decimal(std::string_view const sv) noexcept {
+            auto p = sv.data();
+            auto const end = p + sv.size();
+            auto const negative = std::is_signed_v<T> && p != end && *p == '-';
+            if (negative)
+                ++p;
+            if (p == end || static_cast<size_t>(end - p) > MAX_FAST_DIGITS)
+                return {};
+
+            u64 acc = 0;
+            for (; end - p >= 8 && simd::eight_digits(p); p += 8)
+                acc = acc * 100'000'000 + simd::parse_eight_digits(p);
+            for (; p != end; ++p) {
+                auto const digit = static_cast<unsigned>(*p - '0');
+                if (digit > 9)
+                    return {};
+                acc = acc * 10 + digit;
+            }
+
+            using U = std::make_unsigned_t<T>;
+            if (negative) {
+                if (acc > static_cast<u64>(std::numeric_limits<T>::max()) + 1)
+                    return {};
+                return static_cast<T>(static_cast<U>(0 - static_cast<U>(acc)));
+            }
+            if (acc > static_cast<u64>(std::numeric_limits<T>::max()))
+                return {};
+            return static_cast<T>(acc);
+        }
+
+        template<typename Delimiter, typename Container>
+        static size_t append_tokens(std::string_view const text, Delimiter const& delimiter, Container& out) {
+            size_t n = 0;
+            basic_token_range<Delimiter>::for_each(text, delimiter, [&](std::string_view const token) {
+                out.emplace_back(token);
+                ++n;
+            });
+            return n;
+        }
     public:
         /// Utworzenie wszystkich katalogów pośrednich, włącznie z ostatnim.
         static bool create_dirs(std::string_view path);
@@ -76,37 +337,157 @@ namespace bee {
             std::cout << std::format(fmt, std::forward<Args>(args)...) << " [" << ptr << "]\n" << std::flush;
         }
 
-        /// Zamiana wszystkich znaków tekstu na małe litery.
+        /// Zamiana liter ASCII tekstu na małe litery (wektorowo, niezależnie od locale).
+        /// Bajty spoza ASCII pozostają bez zmian - dla tekstu UTF-8 patrz utf8_to_lower.
         static std::string to_lower(std::string_view const sv) {
             std::string buffer;
-            buffer.reserve(sv.size());
-            for (auto const ch : sv) {
-                auto const c = std::tolower(ch);
-                buffer.push_back(static_cast<char>(c));
-            }
+            // Rozmiar bierzemy z sv - libstdc++ 12 może przekazać tu pojemność zamiast rozmiaru.
+            buffer.resize_and_overwrite(sv.size(), [sv](char* const p, size_t) noexcept {
+                simd::ascii_lower(sv.data(), p, sv.size());
+                return sv.size();
+            });
             return buffer;
         }
 
-        /// Zamiana wszystkich znaków tekstu na duże litery.
+        /// Zamiana liter ASCII tekstu na duże litery (wektorowo, niezależnie od locale).
         static std::string to_upper(std::string_view const sv) {
             std::string buffer;
-            buffer.reserve(sv.size());
-            for (auto const ch : sv) {
-                auto const c = std::toupper(ch);
-                buffer.push_back(static_cast<char>(c));
-            }
+            // Rozmiar bierzemy z sv - libstdc++ 12 może przekazać tu pojemność zamiast rozmiaru.
+            buffer.resize_and_overwrite(sv.size(), [sv](char* const p, size_t) noexcept {
+                simd::ascii_upper(sv.data(), p, sv.size());
+                return sv.size();
+            });
             return buffer;
         }
 
+        /// Zamiana liter ASCII na małe z zapisem do bufora wywołującego (bez alokacji).
+        /// \param sv Tekst źródłowy,
+        /// \param out Bufor docelowy (może być tym samym obszarem co sv).
+        /// \return Zapisana część bufora - min(sv.size(), out.size()) znaków.
+        static std::span<char> to_lower(std::string_view const sv, std::span<char> const out) noexcept {
+            auto const n = std::min(sv.size(), out.size());
+            simd::ascii_lower(sv.data(), out.data(), n);
+            return out.first(n);
+        }
+
+        /// Zamiana liter ASCII na duże z zapisem do bufora wywołującego (bez alokacji).
+        static std::span<char> to_upper(std::string_view const sv, std::span<char> const out) noexcept {
+            auto const n = std::min(sv.size(), out.size());
+            simd::ascii_upper(sv.data(), out.data(), n);
+            return out.first(n);
+        }
+
+        /// Zamiana liter ASCII na małe w miejscu (np. normalizacja kluczy nagłówków).
+        static void lower_in_place(std::string& text) noexcept {
+            simd::ascii_lower(text.data(), text.data(), text.size());
+        }
+
+        /// Zamiana liter ASCII na duże w miejscu.
+        static void upper_in_place(std::string& text) noexcept {
+            simd::ascii_upper(text.data(), text.data(), text.size());
+        }
+
+        /// Równość tekstów bez rozróżniania wielkości liter ASCII (wektorowo, bez alokacji).
+        static bool iequals(std::string_view const a, std::string_view const b) noexcept {
+            return a.size() == b.size() && simd::mismatch_icase(a.data(), b.data(), a.size()) == a.size();
+        }
+
+        /// Porządek tekstów bez rozróżniania wielkości liter ASCII.
+        /// \return Wartość ujemna, zero lub dodatnia - jak std::string_view::compare.
+        static int icompare(std::string_view const a, std::string_view const b) noexcept {
+            auto const n = std::min(a.size(), b.size());
+            if (auto const i = simd::mismatch_icase(a.data(), b.data(), n); i < n)
+                return simd::fold_ascii(a[i]) < simd::fold_ascii(b[i]) ? -1 : 1;
+            return a.size() == b.size() ? 0 : (a.size() < b.size() ? -1 : 1);
+        }
+
+        /// Czy tekst zaczyna się od 'prefix' (bez rozróżniania wielkości liter ASCII).
+        static bool istarts_with(std::string_view const text, std::string_view const prefix) noexcept {
+            return text.size() >= prefix.size() && iequals(text.substr(0, prefix.size()), prefix);
+        }
+
+        /// Czy tekst kończy się na 'suffix' (bez rozróżniania wielkości liter ASCII).
+        static bool iends_with(std::string_view const text, std::string_view const suffix) noexcept {
+            return text.size() >= suffix.size() && iequals(text.substr(text.size() - suffix.size()), suffix);
+        }
+
+        /// Wyszukanie tekstu bez rozróżniania wielkości liter ASCII.
+        /// \param text Przeszukiwany tekst,
+        /// \param needle Szukany tekst,
+        /// \param pos Pozycja, od której zaczyna się wyszukiwanie.
+        /// \return Pozycja pierwszego wystąpienia lub std::string_view::npos - jak std::string_view::find.
+        static size_t ifind(std::string_view const text, std::string_view const needle, size_t const pos = 0) noexcept {
+            if (pos > text.size())
+                return std::string_view::npos;
+            auto const n = text.size() - pos;
+            auto const i = simd::find_substr_icase(text.data() + pos, n, needle.data(), needle.size());
+            return i == n && !needle.empty() ? std::string_view::npos : pos + i;
+        }
+
+        /// Zamiana liter tekstu UTF-8 na małe. \n
+        /// Poza ASCII obsługiwane są litery Latin-1, Latin Extended-A (m.in. polskie),
+        /// greckie i cyrylicy (proste odwzorowanie znak na znak); ciągi ASCII zamieniane są wektorowo.
+        /// Niepoprawne sekwencje UTF-8 i pozostałe znaki kopiowane są bez zmian.
+        static std::string utf8_to_lower(std::string_view sv);
+
+        /// Zamiana liter tekstu UTF-8 na duże (zakres jak w utf8_to_lower).
+        static std::string utf8_to_upper(std::string_view sv);
+
         /// Konwersja tekstu z liczbą całkowitą na liczbę.
         /// \param sv Widok tekstu zawierającego liczbę,
         /// \param base System liczbowy, w którym liczba jest prezentowana w tekście (domyślnie 10)
         /// \return Opcjonalnie wyznaczona liczba
+        /// (błędy wypisywane są na std::cerr - w pętlach lepiej użyć parse<int>).
         static auto to_int(
             std::string_view sv,
             int base = 10) noexcept
         -> std::optional<int>;
 
+        /// Konwersja tekstu na liczbę całkowitą dowolnego typu - bez komunikatów (np. dla kolumn pliku).
+        /// Cały tekst musi być liczbą (jak dla std::from_chars: bez '+' i białych znaków).
+        /// Dla systemu dziesiętnego cyfry przetwarzane są po 8 naraz (simd::parse_eight_digits).
+        /// \param sv Widok tekstu zawierającego liczbę,
+        /// \param base System liczbowy (domyślnie 10).
+        /// \return Liczba lub błąd: std::errc::invalid_argument (to nie jest liczba)
+        /// albo std::errc::result_out_of_range (liczba poza zakresem typu).
+        template<Integer T>
+        static auto parse(
+            std::string_view const sv,
+            int const base = 10) noexcept
+        -> std::expected<T, std::errc>
+        {
+            if (base == 10 && sv.size() <= MAX_FAST_DIGITS + 1)
+                if (auto const value = parse_decimal<T>(sv))
+                    return *value;
+
+            T value{};
+            auto const [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), value, base);
+            if (ec != std::errc{})
+                return std::unexpected{ec};
+            if (ptr != sv.data() + sv.size())
+                return std::unexpected{std::errc::invalid_argument};
+            return value;
+        }
+
+        /// Konwersja tekstu na liczbę zmiennoprzecinkową (std::from_chars) - bez komunikatów.
+        /// \param sv Widok tekstu zawierającego liczbę,
+        /// \param fmt Dopuszczalny zapis liczby (domyślnie stały lub wykładniczy).
+        /// \return Liczba lub błąd jak dla liczb całkowitych.
+        template<std::floating_point T>
+        static auto parse(
+            std::string_view const sv,
+            std::chars_format const fmt = std::chars_format::general) noexcept
+        -> std::expected<T, std::errc>
+        {
+            T value{};
+            auto const [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), value, fmt);
+            if (ec != std::errc{})
+                return std::unexpected{ec};
+            if (ptr != sv.data() + sv.size())
+                return std::unexpected{std::errc::invalid_argument};
+            return value;
+        }
+
         /// Tworzy tekst będący złączeniem tekstów przysłanych w wektorze. \n
         /// Łączone teksty rozdzielone są przysłanym delimiter'em.
         /// \param data Wektor tekstów do połączenia,
@@ -117,6 +498,94 @@ namespace bee {
             const std::string &delimiter = ",") noexcept
         -> std::string;
 
+        /// Złączenie elementów dowolnego zakresu (np. std::vector<std::string_view>)
+        /// lub wyników projekcji elementów (np. pola struktury albo std::to_string liczby). \n
+        /// Puste teksty są pomijane, pozostałe rozdzielane są delimiter'em.
+        /// Dla zakresów wieloprzebiegowych rozmiar wyniku liczony jest dokładnie, przed
+        /// jednokrotną alokacją, a teksty kopiowane są w jednym przejściu (projekcja
+        /// wywoływana jest wtedy dwukrotnie dla każdego elementu).
+        /// \code
+        /// auto const names = box::join(users, ", ", &user::name);
+        /// \endcode
+        /// \param data Zakres elementów do połączenia,
+        /// \param delimiter Tekst wstawiany pomiędzy łączonymi tekstami,
+        /// \param proj Projekcja elementu na tekst.
+        /// \return Złączony tekst.
+        template<std::ranges::input_range R, typename Proj = std::identity>
+            requires std::convertible_to<std::invoke_result_t<Proj&, std::ranges::range_reference_t<R>>, std::string_view>
+        static std::string join(
+            R&& data,
+            std::string_view const delimiter = ",",
+            Proj proj = {})
+        {
+            std::string buffer{};
+            join_into(buffer, std::forward<R>(data), delimiter, std::move(proj));
+            return buffer;
+        }
+
+        /// Jak join, ale złączenie dopisywane jest na końcu tekstu 'out'
+        /// (np. bufora wielokrotnego użytku, który zachowuje pojemność).
+        /// \return Referencja do 'out'.
+        template<std::ranges::input_range R, typename Proj = std::identity>
+            requires std::convertible_to<std::invoke_result_t<Proj&, std::ranges::range_reference_t<R>>, std::string_view>
+        static std::string& join_into(
+            std::string& out,
+            R&& data,
+            std::string_view const delimiter = ",",
+            Proj proj = {})
+        {
+            // fn(widok tekstu elementu). Wynik projekcji trzymamy w zmiennej do końca wywołania fn -
+            // projekcja może zwracać std::string przez wartość (np. std::to_string).
+            auto const with_text = [&proj](auto&& element, auto&& fn) {
+                decltype(auto) value = std::invoke(proj, std::forward<decltype(element)>(element));
+                return fn(std::string_view{value});
+            };
+
+            if constexpr (std::ranges::forward_range<R>) {
+                size_t size = 0, count = 0;
+                for (auto&& element : data) {
+                    if (auto const n = with_text(element, [](std::string_view const token) { return token.size(); })) {
+                        size += n;
+                        ++count;
+                    }
+                }
+                if (count == 0)
+                    return out;
+                size += (count - 1) * delimiter.size();
+
+                auto const offset = out.size();
+                // Rozmiar bierzemy z wyliczenia - libstdc++ 12 może przekazać tu pojemność zamiast rozmiaru.
+                out.resize_and_overwrite(offset + size, [&](char* const buffer, size_t) {
+                    auto dst = buffer + offset;
+                    for (auto&& element : data) {
+                        with_text(element, [&](std::string_view const token) {
+                            if (token.empty())
+                                return;
+                            if (dst != buffer + offset)
+                                dst = std::copy(delimiter.begin(), delimiter.end(), dst);
+                            dst = std::copy(token.begin(), token.end(), dst);
+                        });
+                    }
+                    return offset + size;
+                });
+            }
+            else {
+                // Zakres jednoprzebiegowy - rozmiaru nie da się poznać z góry.
+                auto first = true;
+                for (auto&& element : data) {
+                    with_text(element, [&](std::string_view const token) {
+                        if (token.empty())
+                            return;
+                        if (!first)
+                            out.append(delimiter);
+                        out.append(token);
+                        first = false;
+                    });
+                }
+            }
+            return out;
+        }
+
         /// Konwersja liczby całkowitej na tekst.
         /// Formatowanie obejmuje separatory tysięcy.
         /// \param value Wartość do sformatowania,
@@ -243,7 +712,182 @@ namespace bee {
             char delimiter) noexcept
         -> std::vector<std::string>;
 
+        /// Podział tekstu bez kopiowania - wynikiem są widoki na przysłany tekst. \n
+        /// Fragmenty jak w split (bez białych znaków na brzegach, bez pustych).
+        /// \param text Tekst do podziału (musi istnieć dłużej niż wynik),
+        /// \param delimiter Znak sygnalizujący podział,
+        /// \return Wektor widoków.
+        static auto split_view(
+            std::string_view text,
+            char delimiter) noexcept
+        -> std::vector<std::string_view>;
+
+        // Widoki na tymczasowy string byłyby nieważne po powrocie.
+        template<typename S> requires std::same_as<S, std::string>
+        static auto split_view(S&&, char) = delete;
+
+        /// Podział tekstu na widoki rozdzielone ciągiem znaków (np. ", " lub "||"). \n
+        /// Wystąpienia ciągu wyszukiwane są wektorowo; pusty ciąg nie dzieli tekstu.
+        /// \param text Tekst do podziału (musi istnieć dłużej niż wynik),
+        /// \param delimiter Ciąg znaków sygnalizujący podział,
+        /// \return Wektor widoków.
+        static auto split_view(
+            std::string_view text,
+            std::string_view delimiter) noexcept
+        -> std::vector<std::string_view>;
+
+        template<typename S> requires std::same_as<S, std::string>
+        static auto split_view(S&&, std::string_view) = delete;
+
+        /// Podział tekstu na widoki rozdzielone dowolnym ze znaków 'delimiters' (np. ";,\t"). \n
+        /// Znaki należące do zbioru rozpoznawane są wektorowo (simd::byte_set).
+        /// \param text Tekst do podziału (musi istnieć dłużej niż wynik),
+        /// \param delimiters Znaki sygnalizujące podział,
+        /// \return Wektor widoków.
+        static auto split_view_any(
+            std::string_view text,
+            std::string_view delimiters) noexcept
+        -> std::vector<std::string_view>;
+
+        template<typename S> requires std::same_as<S, std::string>
+        static auto split_view_any(S&&, std::string_view) = delete;
+
+        /// Podział tekstu z dopisaniem fragmentów do kontenera wywołującego
+        /// (np. std::vector<std::string_view> lub std::vector<std::string>). \n
+        /// Kontener nie jest czyszczony - po clear() zachowuje pojemność, więc w pętli
+        /// po liniach pliku kolejne wywołania nie alokują pamięci.
+        /// \code
+        /// std::vector<std::string_view> fields;
+        /// for (auto const line : box::lines(content)) {
+        ///     fields.clear();
+        ///     box::split_into(line, ';', fields);
+        ///     ...
+        /// }
+        /// \endcode
+        /// \param text Tekst do podziału,
+        /// \param delimiter Znak sygnalizujący podział,
+        /// \param out Kontener, do którego dopisywane są fragmenty.
+        /// \return Liczba dopisanych fragmentów.
+        template<typename Container>
+            requires requires(Container& c, std::string_view const sv) { c.emplace_back(sv); }
+        static size_t split_into(
+            std::string_view const text,
+            char const delimiter,
+            Container& out)
+        {
+            return append_tokens(text, delimiter, out);
+        }
+
+        /// Jak wyżej, dla delimitera będącego ciągiem znaków.
+        template<typename Container>
+            requires requires(Container& c, std::string_view const sv) { c.emplace_back(sv); }
+        static size_t split_into(
+            std::string_view const text,
+            std::string_view const delimiter,
+            Container& out)
+        {
+            return append_tokens(text, delimiter, out);
+        }
+
+        /// Jak wyżej, dla dowolnego znaku ze zbioru (np. simd::byte_set{";,\t"}).
+        template<typename Container>
+            requires requires(Container& c, std::string_view const sv) { c.emplace_back(sv); }
+        static size_t split_into(
+            std::string_view const text,
+            simd::byte_set const& delimiters,
+            Container& out)
+        {
+            return append_tokens(text, delimiters, out);
+        }
+
+        /// Podział tekstu z pamięcią z przysłanego zasobu (std::pmr). \n
+        /// Z std::pmr::monotonic_buffer_resource zwalnianym (release) po każdej linii
+        /// podział nie korzysta ze sterty, dopóki mieści się w buforze zasobu.
+        /// \code
+        /// std::array<std::byte, 4096> buffer;
+        /// std::pmr::monotonic_buffer_resource pool{buffer.data(), buffer.size()};
+        /// for (auto const line : box::lines(content)) {
+        ///     auto const fields = box::split_view(line, ';', &pool);
+        ///     ...
+        ///     pool.release();     // po zniszczeniu 'fields'
+        /// }
+        /// \endcode
+        static auto split_view(
+            std::string_view const text,
+            char const delimiter,
+            std::pmr::memory_resource* const resource)
+        -> std::pmr::vector<std::string_view>
+        {
+            std::pmr::vector<std::string_view> tokens{resource};
+            tokens.reserve(simd::count_byte(text.data(), text.size(), delimiter) + 1);
+            split_into(text, delimiter, tokens);
+            return tokens;
+        }
+
+        /// Jak split, ale wektor i teksty fragmentów korzystają z przysłanego zasobu.
+        static auto split(
+            std::string_view const text,
+            char const delimiter,
+            std::pmr::memory_resource* const resource)
+        -> std::pmr::vector<std::pmr::string>
+        {
+            std::pmr::vector<std::pmr::string> tokens{resource};
+            tokens.reserve(simd::count_byte(text.data(), text.size(), delimiter) + 1);
+            split_into(text, delimiter, tokens);
+            return tokens;
+        }
+
+        /// Leniwy podział tekstu - kolejne fragmenty wyznaczane są przy iteracji, bez alokacji.
+        /// \code
+        /// for (auto const field : box::split_range(line, ';'))
+        ///     ...
+        /// \endcode
+        static token_range split_range(
+            std::string_view const text,
+            char const delimiter) noexcept
+        {
+            return {text, delimiter};
+        }
+
+        template<typename S> requires std::same_as<S, std::string>
+        static token_range split_range(S&&, char) = delete;
+
+        /// Leniwy podział tekstu rozdzielonego ciągiem znaków (ciąg musi istnieć dłużej niż zakres).
+        static basic_token_range<std::string_view> split_range(
+            std::string_view const text,
+            std::string_view const delimiter) noexcept
+        {
+            return {text, delimiter};
+        }
+
+        template<typename S> requires std::same_as<S, std::string>
+        static auto split_range(S&&, std::string_view) = delete;
+
+        /// Leniwy podział tekstu rozdzielonego dowolnym ze znaków 'delimiters'.
+        static basic_token_range<simd::byte_set> split_range_any(
+            std::string_view const text,
+            std::string_view const delimiters) noexcept
+        {
+            return {text, simd::byte_set{delimiters}};
+        }
+
+        template<typename S> requires std::same_as<S, std::string>
+        static auto split_range_any(S&&, std::string_view) = delete;
+
+        /// Leniwy podział tekstu na linie (bez znaków końca linii, bez alokacji).
+        /// \code
+        /// for (auto const line : box::lines(content))
+        ///     ...
+        /// \endcode
+        static line_range lines(std::string_view const text) noexcept {
+            return line_range{text};
+        }
+
+        template<typename S> requires std::same_as<S, std::string>
+        static line_range lines(S&&) = delete;
+
         /// Utworzenie wektora losowych bajtów.
+        /// Bajty pochodzą z generatora ChaCha20 bieżącego wątku (csprng).
         /// \param n - oczekiwana liczba bajtów.
         /// \return Wektor losowych bajtów.
         template<typename T>
@@ -251,35 +895,48 @@ namespace bee {
             if (n == 0)
                 return std::vector<T>{};
 
-            std::random_device rd;
-            std::array<int, std::mt19937::state_size> seed_data{};
-            std::ranges::generate(seed_data, ref(rd));
-            std::seed_seq seq(begin(seed_data), end(seed_data));
-
-            auto mersenne_twister_engine = std::mt19937{seq};
-            auto ud = std::uniform_int_distribution<>{0, 255};
-
-            std::vector<T> buffer;
-            buffer.reserve(n);
-            for (auto i = 0; i < n; ++i) {
-                auto const c = ud(mersenne_twister_engine);
-                buffer.push_back(static_cast<T>(c));
+            std::vector<T> buffer(n);
+            if constexpr (sizeof(T) == 1)
+                csprng::instance().fill(buffer.data(), n);
+            else {
+                // Każdy element to jeden losowy bajt (0..255).
+                std::vector<u8> bytes(n);
+                csprng::instance().fill(bytes.data(), n);
+                std::ranges::transform(bytes, buffer.begin(), [](u8 const c) { return static_cast<T>(c); });
             }
             return buffer;
         }
 
+        /// Wypełnienie pamięci wywołującego losowymi bajtami (bez alokacji).
+        /// \param data Span bajtów do wypełnienia.
+        static void fill_random(std::span<std::byte> const data) noexcept {
+            csprng::instance().fill(data.data(), data.size());
+        }
+
+        /// Wypełnienie losowymi bajtami spanu dowolnego typu prostego (np. u8, u32).
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        static void fill_random(std::span<T> const data) noexcept {
+            csprng::instance().fill(data.data(), data.size_bytes());
+        }
+
+        /// Wypełnienie nbytes bajtów od adresu data losowymi bajtami.
+        static void fill_random(void* const data, size_t const nbytes) noexcept {
+            csprng::instance().fill(data, nbytes);
+        }
+
         /// Sprawdzenie, czy przysłany znak NIE jest białym znakiem.
         /// \param c Znak do sprawdzenia
         /// \return TRUE, jeśli NIE jest białym znakiem, FALSE w przeciwnym przypadku (jest białym znakiem).
         static bool is_not_space(const char c) noexcept {
-            return !std::isspace(c);
+            return !simd::is_space(c);
         }
 
         /// Obcięcie początkowych białych znaków.
         /// \param s Tekst, z którego należy usunąć białe znaki
         /// \return Tekst bez początkowych białych znaków.
         static std::string trim_left(std::string s) noexcept {
-            s.erase(s.begin(), std::ranges::find_if(s, is_not_space));
+            s.erase(0, simd::leading_space(s.data(), s.size()));
             return s;
         }
 
@@ -287,7 +944,7 @@ namespace bee {
         /// \param s Tekst, z którego należy usunąć białe znaki
         /// \return Tekst bez zamykających białych znaków.
         static std::string trim_right(std::string s) noexcept {
-            s.erase(std::find_if(s.rbegin(), s.rend(), is_not_space).base(), s.end());
+            s.resize(s.size() - simd::trailing_space(s.data(), s.size()));
             return s;
         }
 
@@ -298,6 +955,24 @@ namespace bee {
             return trim_left(trim_right(std::move(s)));
         }
 
+        /// Widok tekstu bez początkowych białych znaków (bez kopiowania).
+        /// Białe znaki jak std::isspace w locale "C", rozpoznawane tablicą (simd::SPACE).
+        static std::string_view trim_view_left(std::string_view sv) noexcept {
+            sv.remove_prefix(simd::leading_space(sv.data(), sv.size()));
+            return sv;
+        }
+
+        /// Widok tekstu bez końcowych białych znaków (bez kopiowania).
+        static std::string_view trim_view_right(std::string_view sv) noexcept {
+            sv.remove_suffix(simd::trailing_space(sv.data(), sv.size()));
+            return sv;
+        }
+
+        /// Widok tekstu bez początkowych i końcowych białych znaków (bez kopiowania).
+        static std::string_view trim_view(std::string_view const sv) noexcept {
+            return token_range::trimmed(sv);
+        }
+
         /// Zamiana całego kontenera bajtów na tekst,
         /// w którym liczby rozdzielone są przecinkami.
         /// \param data Widok kontenera bajtów do konwersji.
@@ -25,7 +25,9 @@
 
 /*------- include files:
 -------------------------------------------------------------------*/
+#include <bit>
 #include <cstdint>
+#include <cstring>
 #include <span>
 #include <string>
 #include <vector>
@@ -56,4 +58,87 @@ namespace bee {
     using u64 = uint64_t;
     using f32 = float;
     using f64 = double;
-}
\ No newline at end of file
+
+    /*------- load/store:
+    -------------------------------------------------------------------*/
+    // Odczyt i zapis 32-bitowych słów w ustalonej kolejności bajtów z/do buforów
+    // o dowolnym wyrównaniu (np. mmap lub przesunięty fragment).
+    // memcpy + std::byteswap kompilator zamienia na pojedyncze mov, bswap lub movbe,
+    // a pętle wersji 'wielotorowych' (tablica N słów) na przetasowania SIMD.
+
+    inline u32 load_le32(void const* const src) noexcept {
+        u32 v;
+        std::memcpy(&v, src, sizeof(v));
+        if constexpr (std::endian::native == std::endian::big)
+            v = std::byteswap(v);
+        return v;
+    }
+
+    inline u32 load_be32(void const* const src) noexcept {
+        u32 v;
+        std::memcpy(&v, src, sizeof(v));
+        if constexpr (std::endian::native == std::endian::little)
+            v = std::byteswap(v);
+        return v;
+    }
+
+    inline void store_le32(void* const dst, u32 v) noexcept {
+        if constexpr (std::endian::native == std::endian::big)
+            v = std::byteswap(v);
+        std::memcpy(dst, &v, sizeof(v));
+    }
+
+    inline void store_be32(void* const dst, u32 v) noexcept {
+        if constexpr (std::endian::native == std::endian::little)
+            v = std::byteswap(v);
+        std::memcpy(dst, &v, sizeof(v));
+    }
+
+    inline u64 load_le64(void const* const src) noexcept {
+        u64 v;
+        std::memcpy(&v, src, sizeof(v));
+        if constexpr (std::endian::native == std::endian::big)
+            v = std::byteswap(v);
+        return v;
+    }
+
+    template<std::size_t N>
+    void load_le32(void const* const src, u32 (&dst)[N]) noexcept {
+        std::memcpy(dst, src, sizeof(dst));
+        if constexpr (std::endian::native == std::endian::big)
+            for (auto& v : dst)
+                v = std::byteswap(v);
+    }
+
+    template<std::size_t N>
+    void load_be32(void const* const src, u32 (&dst)[N]) noexcept {
+        std::memcpy(dst, src, sizeof(dst));
+        if constexpr (std::endian::native == std::endian::little)
+            for (auto& v : dst)
+                v = std::byteswap(v);
+    }
+
+    template<std::size_t N>
+    void store_le32(void* const dst, u32 const (&src)[N]) noexcept {
+        if constexpr (std::endian::native == std::endian::big) {
+            u32 tmp[N];
+            for (std::size_t i = 0; i < N; ++i)
+                tmp[i] = std::byteswap(src[i]);
+            std::memcpy(dst, tmp, sizeof(tmp));
+        }
+        else
+            std::memcpy(dst, src, sizeof(src));
+    }
+
+    template<std::size_t N>
+    void store_be32(void* const dst, u32 const (&src)[N]) noexcept {
+        if constexpr (std::endian::native == std::endian::little) {
+            u32 tmp[N];
+            for (std::size_t i = 0; i < N; ++i)
+                tmp[i] = std::byteswap(src[i]);
+            std::memcpy(dst, tmp, sizeof(tmp));
+        }
+        else
+            std::memcpy(dst, src, sizeof(src));
+    }
+}